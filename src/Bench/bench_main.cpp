@@ -0,0 +1,739 @@
+/**
+ * @brief Headless gameplay benchmark.
+ *
+ * Runs Game_world of the selected levels for a fixed amount of simulated
+ * time without a window, driven by random or scripted input, and prints
+ * throughput, per-phase cost and peak entity counts as JSON.
+ *
+ * With --replay the recorded run is played back instead (its level, seed,
+ * tick rate and length override the other options) and checked for
+ * divergence against the recorded state hashes.
+ *
+ * With --kernels the SIMD kernels are compared against the per-object scalar
+ * path (position integration, one-vs-many box overlap) at 1k, 10k and 100k
+ * entities instead.
+ *
+ * With --db score upserts are run against an in-memory SQLite database with
+ * the prepared statement cache disabled and enabled instead (--db-rows
+ * upserts each).
+ *
+ * With --stress level 0 is loaded with a swarm of --stress-enemies enemies
+ * and --stress-bullets bullets (topped up before every tick) and run for
+ * --stress-ticks ticks at 1, 2, 4, ... threads up to --threads (all cores
+ * if --threads is not given), reporting per-phase cost, speedup over one
+ * thread and whether the final state hash matches the serial run.
+ *
+ * Usage: sfml_airplane_bench [--seconds=<s>] [--tick-rate=<hz>] [--levels=0,1]
+ *                            [--seed=<n>] [--input=random|scripted] [--out=<path>]
+ *                            [--replay=<path>] [--trace=<path>] [--kernels]
+ *                            [--threads=<n>] [--db] [--db-rows=<n>]
+ *                            [--stress] [--stress-enemies=<n>] [--stress-bullets=<n>]
+ *                            [--stress-ticks=<n>]
+ *
+ * --threads runs entity movement on a job system with n threads (1 = serial,
+ * the default); state hashes do not depend on it.
+ *
+ * --trace writes the recorded profiling zones as Chrome trace JSON (needs a
+ * debug build or FLEV_ENABLE_PROFILING).
+ */
+#include <Level/Game_world.hpp>
+#include <Level/Replay.hpp>
+#include <utils/profiler.hpp>
+#include <utils/simd_kernels.hpp>
+#include <utils/database_api.hpp>
+#include <Entities/Enemy_archetypes.hpp>
+#include <nlohmann/json.hpp>
+#include <SFML/Graphics.hpp>
+#include <string_view>
+#include <charconv>
+#include <iostream>
+#include <fstream>
+#include <chrono>
+#include <random>
+#include <memory>
+
+namespace
+{
+    /** @brief Command line options. */
+    struct Bench_options
+    {
+        float seconds = 120.f;              ///< Simulated seconds per level.
+        uint32_t tick_rate = 60u;           ///< Simulation ticks per simulated second.
+        uint32_t seed = 1u;                 ///< Seed for input and enemy spawns.
+        bool scripted = false;              ///< Scripted (true) or random (false) input.
+        std::vector<int32_t> levels{ 0, 1 }; ///< Levels to run.
+        std::string output_path;            ///< JSON report path (stdout if empty).
+        std::string replay_path;            ///< Replay to play back (random/scripted input if empty).
+        std::string trace_path;             ///< Chrome trace output path (no trace if empty).
+        bool kernels = false;               ///< Run SIMD kernel microbenchmarks instead of levels.
+        uint32_t threads = 1u;              ///< Threads running entity movement (1 = serial).
+        bool db = false;                    ///< Run database upsert benchmark instead of levels.
+        uint32_t db_rows = 20000u;          ///< Upserts per database benchmark mode.
+        bool stress = false;                ///< Run swarm thread scaling benchmark instead of levels.
+        uint32_t stress_enemies = 4000u;    ///< Live enemies kept in the swarm.
+        uint32_t stress_bullets = 4000u;    ///< Live bullets kept in the swarm (both pools).
+        uint32_t stress_ticks = 600u;       ///< Ticks per thread count.
+    };
+
+    /** @brief Enemy archetype names used as JSON keys (indexed by Enemy_type). */
+    constexpr std::array<const char*, enemy_type_count> enemy_type_names = {
+        "big_stone", "small_stone", "scout", "warrior"
+    };
+
+    /** @brief Texture size assumed when an asset is missing (bench still runs). */
+    constexpr sf::Vector2f fallback_texture_size = { 512.f, 512.f };
+
+    /** @brief Parses the numeric value of "--name=<value>" into out (left unchanged on error). */
+    template <typename T>
+    void parse_value(const std::string_view value, T& out)
+    {
+        std::from_chars(value.data(), value.data() + value.size(), out);
+    }//!parse_value
+
+    /** @returns Options parsed from the command line. */
+    Bench_options parse_options(const int argc, char** argv)
+    {
+        Bench_options options;
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string_view arg = argv[i];
+            const auto eq = arg.find('=');
+            const auto name = arg.substr(0, eq);
+            const auto value = eq == std::string_view::npos ? std::string_view{} : arg.substr(eq + 1);
+
+            if (name == "--seconds") parse_value(value, options.seconds);
+            else if (name == "--tick-rate") parse_value(value, options.tick_rate);
+            else if (name == "--seed") parse_value(value, options.seed);
+            else if (name == "--input") options.scripted = (value == "scripted");
+            else if (name == "--out") options.output_path = value;
+            else if (name == "--replay") options.replay_path = value;
+            else if (name == "--trace") options.trace_path = value;
+            else if (name == "--kernels") options.kernels = true;
+            else if (name == "--threads") parse_value(value, options.threads);
+            else if (name == "--db") options.db = true;
+            else if (name == "--db-rows") parse_value(value, options.db_rows);
+            else if (name == "--stress") options.stress = true;
+            else if (name == "--stress-enemies") parse_value(value, options.stress_enemies);
+            else if (name == "--stress-bullets") parse_value(value, options.stress_bullets);
+            else if (name == "--stress-ticks") parse_value(value, options.stress_ticks);
+            else if (name == "--levels")
+            {
+                options.levels.clear();
+                for (auto rest = value; !rest.empty(); )
+                {
+                    const auto comma = rest.find(',');
+                    int32_t level_id = -1;
+                    parse_value(rest.substr(0, comma), level_id);
+                    if (level_id >= 0) options.levels.push_back(level_id);
+                    rest = comma == std::string_view::npos ? std::string_view{} : rest.substr(comma + 1);
+                }
+            }
+            else
+            {
+                std::cerr << "Unknown option: " << arg << '\n';
+            }
+        }
+        options.tick_rate = std::clamp(options.tick_rate, 10u, 240u);
+        options.threads = std::max(options.threads, 1u);
+        options.stress_ticks = std::max(options.stress_ticks, 1u);
+        return options;
+    }//!parse_options
+
+    /**
+     * @brief Decodes the texture on the CPU and returns its scaled size.
+     *
+     * sf::Image does not need a GL context, unlike sf::Texture.
+     *
+     * @param mask[out]  - Collision mask at sprite scale (left empty if the file could not be loaded).
+     * @param found[out] - Cleared if the file could not be loaded.
+     */
+    sf::Vector2f get_scaled_size(const char* texture_path, const sf::Vector2f& scale, Collision_mask& mask, bool& found)
+    {
+        sf::Image image;
+        sf::Vector2f size = fallback_texture_size;
+        if (image.loadFromFile(texture_path))
+        {
+            size = sf::Vector2f(image.getSize());
+            mask = Collision_mask(image).scaled(scale);
+        }
+        else
+        {
+            found = false;
+        }
+        return { size.x * scale.x, size.y * scale.y };
+    }//!get_scaled_size
+
+    /** @brief Scaled sprite sizes and collision masks of all entities. */
+    struct Entity_sizes
+    {
+        sf::Vector2f player;                                      ///< Player ship.
+        std::array<sf::Vector2f, enemy_type_count> enemies;       ///< Enemy archetypes (indexed by Enemy_type).
+        sf::Vector2f bullet;                                      ///< Player bullet.
+        sf::Vector2f enemy_bullet;                                ///< Enemy bullet.
+        Collision_mask player_mask;                               ///< Player ship mask.
+        std::array<Collision_mask, enemy_type_count> enemy_masks; ///< Enemy archetype masks.
+        Collision_mask bullet_mask;                               ///< Player bullet mask.
+        Collision_mask enemy_bullet_mask;                         ///< Enemy bullet mask.
+        bool assets_found = true;                                 ///< false if any size is a fallback.
+    };
+
+    /** @returns Entity sizes read from the asset images. */
+    Entity_sizes load_entity_sizes()
+    {
+        Entity_sizes sizes;
+        auto& found = sizes.assets_found;
+        sizes.player = get_scaled_size(Player::texture_path, Player::scale, sizes.player_mask, found);
+        for_each_enemy_archetype([&]<typename T>(std::type_identity<T>) {
+            const auto type_id = to_index(T::type);
+            sizes.enemies[type_id] = get_scaled_size(T::texture_path, T::scale, sizes.enemy_masks[type_id], found);
+        });
+        sizes.bullet = get_scaled_size(Bullet::texture_path, Bullet::scale, sizes.bullet_mask, found);
+        sizes.enemy_bullet = get_scaled_size(Enemy_bullet::texture_path, Enemy_bullet::scale, sizes.enemy_bullet_mask, found);
+        return sizes;
+    }//!load_entity_sizes
+
+    /** @returns New world of the given level with entity sizes applied (allocating from the level arena). */
+    std::unique_ptr<Game_world> make_world(
+        const int32_t level_id,
+        const Entity_sizes& sizes,
+        Job_system& job_system,
+        Level_arena& level_arena,
+        const uint64_t seed,
+        const sf::Vector2u& world_size = { 1920u, 1080u },
+        const size_t bullet_capacity = Game_world::default_bullet_capacity
+    )
+    {
+        auto world = std::make_unique<Game_world>(level_id, world_size, seed, level_arena.get_resource(), bullet_capacity);
+        world->set_job_system(&job_system);
+        world->set_player_size(sizes.player);
+        world->set_player_mask(sizes.player_mask);
+        for (size_t type_id = 0; type_id < enemy_type_count; ++type_id)
+        {
+            world->set_enemy_size(static_cast<Enemy_type>(type_id), sizes.enemies[type_id]);
+            world->set_enemy_mask(static_cast<Enemy_type>(type_id), sizes.enemy_masks[type_id]);
+        }
+        world->set_bullet_sizes(sizes.bullet, sizes.enemy_bullet);
+        world->set_bullet_masks(sizes.bullet_mask, sizes.enemy_bullet_mask);
+        return world;
+    }//!make_world
+
+    /**
+     * @brief Player input generator.
+     *
+     * Random mode holds a random direction for a random number of ticks and
+     * fires most of the time. Scripted mode always fires and sweeps the
+     * player up and down the screen, which keeps the bullet pool busy.
+     */
+    class Input_source
+    {
+    public:
+        Input_source(const bool scripted, const uint32_t seed, const uint32_t tick_rate)
+            : scripted_(scripted)
+            , tick_rate_(tick_rate)
+            , rng_(seed)
+        {
+        }//!Input_source
+
+        /** @returns Input for the given tick. */
+        Player_input next(const uint64_t tick)
+        {
+            if (scripted_)
+            {
+                // 2 seconds up, 2 seconds down
+                const bool going_up = (tick / (2u * tick_rate_)) % 2u == 0u;
+                return { .up = going_up, .down = !going_up, .shoot = true };
+            }
+
+            if (hold_ticks_ == 0u)
+            {
+                std::uniform_int_distribution<uint32_t> bits(0u, 15u);
+                std::uniform_int_distribution<uint32_t> hold(tick_rate_ / 10u, tick_rate_);
+                std::bernoulli_distribution fire(0.8);
+
+                const auto direction = bits(rng_);
+                held_ = {
+                    .up = (direction & 1u) != 0u,
+                    .down = (direction & 2u) != 0u,
+                    .left = (direction & 4u) != 0u,
+                    .right = (direction & 8u) != 0u,
+                    .shoot = fire(rng_)
+                };
+                hold_ticks_ = hold(rng_);
+            }
+            --hold_ticks_;
+            return held_;
+        }//!next
+
+    private:
+        bool scripted_;           ///< Scripted (true) or random (false) input.
+        uint32_t tick_rate_;      ///< Ticks per simulated second.
+        std::mt19937 rng_;        ///< Random input source.
+        Player_input held_;       ///< Random input held for hold_ticks_.
+        uint32_t hold_ticks_ = 0; ///< Ticks left until the next random input.
+    };
+
+    /** @brief Runs one level for options.seconds of simulated time and returns its report. */
+    nlohmann::json run_level(
+        const int32_t level_id,
+        const Bench_options& options,
+        const Entity_sizes& sizes,
+        Job_system& job_system
+    )
+    {
+        const float dt = 1.f / static_cast<float>(options.tick_rate);
+        const auto total_ticks = static_cast<uint64_t>(options.seconds * static_cast<float>(options.tick_rate));
+
+        Input_source input(options.scripted, options.seed, options.tick_rate);
+
+        World_stats total;
+        size_t peak_bullets = 0, peak_enemy_bullets = 0, dropped_bullets = 0;
+        uint32_t runs = 0, victories = 0, defeats = 0;
+
+        // Accumulates statistics of a finished (or interrupted) run
+        const auto collect = [&](const Game_world& world) {
+            const auto& stats = world.get_stats();
+            total.ticks += stats.ticks;
+            total.spawn_time += stats.spawn_time;
+            total.movement_time += stats.movement_time;
+            total.collision_time += stats.collision_time;
+            total.broadphase_time += stats.broadphase_time;
+            for (size_t type_id = 0; type_id < enemy_type_count; ++type_id)
+            {
+                total.peak_enemies[type_id] = std::max(total.peak_enemies[type_id], stats.peak_enemies[type_id]);
+            }
+            peak_bullets = std::max(peak_bullets, world.get_bullets().get_high_water_mark());
+            peak_enemy_bullets = std::max(peak_enemy_bullets, world.get_enemy_bullets().get_high_water_mark());
+            dropped_bullets += world.get_bullets().get_dropped_count() + world.get_enemy_bullets().get_dropped_count();
+            ++runs;
+        };
+
+        const auto wall_start = std::chrono::steady_clock::now();
+
+        // The level restarts when it ends (with the next seed), so every level runs the same simulated time
+        // Every run gets a fresh level arena, released in one shot after its world
+        auto level_arena = std::make_unique<Level_arena>();
+        auto world = make_world(level_id, sizes, job_system, *level_arena, options.seed);
+        for (uint64_t tick = 0; tick < total_ticks; ++tick)
+        {
+            const auto status = world->update(dt, input.next(tick));
+            if (status == World_status::Running) continue;
+
+            if (status == World_status::Victory) ++victories;
+            else ++defeats;
+            collect(*world);
+            world.reset();
+            level_arena = std::make_unique<Level_arena>();
+            world = make_world(level_id, sizes, job_system, *level_arena, options.seed + runs);
+        }
+        collect(*world);
+
+        const auto wall_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall_start).count();
+        const auto ticks = static_cast<double>(std::max<uint64_t>(total.ticks, 1u));
+
+        nlohmann::json report;
+        report["level_id"] = level_id;
+        report["ticks"] = total.ticks;
+        report["runs"] = runs;
+        report["victories"] = victories;
+        report["defeats"] = defeats;
+        report["wall_seconds"] = wall_seconds;
+        report["ticks_per_second"] = wall_seconds > 0.0 ? static_cast<double>(total.ticks) / wall_seconds : 0.0;
+        report["phase_us_per_tick"] = {
+            { "spawn", total.spawn_time * 1e6 / ticks },
+            { "movement", total.movement_time * 1e6 / ticks },
+            { "collisions", total.collision_time * 1e6 / ticks },
+            { "broadphase", total.broadphase_time * 1e6 / ticks }
+        };
+
+        nlohmann::json peaks;
+        for (size_t type_id = 0; type_id < enemy_type_count; ++type_id)
+        {
+            peaks[enemy_type_names[type_id]] = total.peak_enemies[type_id];
+        }
+        peaks["bullets"] = peak_bullets;
+        peaks["enemy_bullets"] = peak_enemy_bullets;
+        report["peak_counts"] = peaks;
+        report["dropped_bullets"] = dropped_bullets;
+        return report;
+    }//!run_level
+
+    /** @brief Plays back a recorded run and returns its report (timings and divergence). */
+    nlohmann::json run_replay(const Replay& replay, const Entity_sizes& sizes, Job_system& job_system)
+    {
+        const float dt = 1.f / static_cast<float>(replay.tick_rate);
+        Level_arena level_arena;
+        auto world = make_world(replay.level_id, sizes, job_system, level_arena, replay.seed, replay.world_size);
+        Replay_player player(replay);
+
+        const auto wall_start = std::chrono::steady_clock::now();
+        auto status = World_status::Running;
+        while (player.has_next() && status == World_status::Running)
+        {
+            status = world->update(dt, player.get_input());
+            player.advance(world->compute_state_hash());
+        }
+        const auto wall_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall_start).count();
+
+        const auto& stats = world->get_stats();
+        const auto ticks = static_cast<double>(std::max<uint64_t>(stats.ticks, 1u));
+
+        nlohmann::json report;
+        report["level_id"] = replay.level_id;
+        report["ticks"] = stats.ticks;
+        report["recorded_ticks"] = replay.inputs.size();
+        report["diverged_at_tick"] = player.get_divergence_tick();
+        report["score"] = world->get_score();
+        report["wall_seconds"] = wall_seconds;
+        report["ticks_per_second"] = wall_seconds > 0.0 ? static_cast<double>(stats.ticks) / wall_seconds : 0.0;
+        report["phase_us_per_tick"] = {
+            { "spawn", stats.spawn_time * 1e6 / ticks },
+            { "movement", stats.movement_time * 1e6 / ticks },
+            { "collisions", stats.collision_time * 1e6 / ticks },
+            { "broadphase", stats.broadphase_time * 1e6 / ticks }
+        };
+        return report;
+    }//!run_replay
+
+    /**
+     * @brief Runs the swarm at 1, 2, 4, ... threads and returns one report per thread count.
+     *
+     * Every thread count simulates the same ticks from the same seed and
+     * input, so its final state hash must equal the serial one.
+     */
+    nlohmann::json run_stress(const Bench_options& options, const Entity_sizes& sizes)
+    {
+        constexpr int32_t level_id = 0; // Timed level: destroying the swarm never ends the run
+        const float dt = 1.f / static_cast<float>(options.tick_rate);
+
+        const size_t max_threads = options.threads > 1u ? options.threads : Job_system::get_default_worker_count() + 1u;
+        std::vector<size_t> thread_counts;
+        for (size_t threads = 1u; threads < max_threads; threads *= 2u) thread_counts.push_back(threads);
+        thread_counts.push_back(max_threads);
+
+        // Refills the swarm to its target size (kills, despawns and the player's death thin it out)
+        const auto top_up = [&](Game_world& world) {
+            size_t enemies = 0u;
+            for (size_t type_id = 0; type_id < enemy_type_count; ++type_id)
+            {
+                enemies += world.get_enemies(static_cast<Enemy_type>(type_id)).size();
+            }
+            const size_t bullets = world.get_bullets().size() + world.get_enemy_bullets().size();
+            world.spawn_swarm(
+                options.stress_enemies > enemies ? options.stress_enemies - enemies : 0u,
+                options.stress_bullets > bullets ? options.stress_bullets - bullets : 0u
+            );
+        };
+
+        nlohmann::json report = nlohmann::json::array();
+        double serial_tick_us = 0.0, serial_movement_us = 0.0, serial_collision_us = 0.0, serial_broadphase_us = 0.0;
+        uint64_t serial_hash = 0u;
+        for (const auto threads : thread_counts)
+        {
+            Job_system job_system(threads - 1u);
+            Input_source input(options.scripted, options.seed, options.tick_rate);
+
+            World_stats total;
+            size_t dropped_bullets = 0;
+            uint32_t runs = 0;
+            const auto collect = [&](const Game_world& world) {
+                const auto& stats = world.get_stats();
+                total.ticks += stats.ticks;
+                total.spawn_time += stats.spawn_time;
+                total.movement_time += stats.movement_time;
+                total.collision_time += stats.collision_time;
+                total.broadphase_time += stats.broadphase_time;
+                dropped_bullets += world.get_bullets().get_dropped_count() + world.get_enemy_bullets().get_dropped_count();
+                ++runs;
+            };
+
+            // Each pool can hold the whole swarm, so shots of warriors are not dropped either
+            const auto make_stress_world = [&](Level_arena& level_arena, const uint64_t seed) {
+                return make_world(level_id, sizes, job_system, level_arena, seed, { 1920u, 1080u }, options.stress_bullets);
+            };
+
+            const auto wall_start = std::chrono::steady_clock::now();
+            auto level_arena = std::make_unique<Level_arena>();
+            auto world = make_stress_world(*level_arena, options.seed);
+            for (uint32_t tick = 0; tick < options.stress_ticks; ++tick)
+            {
+                top_up(*world);
+                if (world->update(dt, input.next(tick)) == World_status::Running) continue;
+
+                // Restart as run_level() does, the swarm is rebuilt on the next tick
+                collect(*world);
+                world.reset();
+                level_arena = std::make_unique<Level_arena>();
+                world = make_stress_world(*level_arena, options.seed + runs);
+            }
+            collect(*world);
+            const auto wall_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall_start).count();
+
+            const auto ticks = static_cast<double>(std::max<uint64_t>(total.ticks, 1u));
+            const auto movement_us = total.movement_time * 1e6 / ticks;
+            const auto collision_us = total.collision_time * 1e6 / ticks;
+            const auto broadphase_us = total.broadphase_time * 1e6 / ticks;
+            const auto tick_us = total.spawn_time * 1e6 / ticks + movement_us + collision_us;
+            const auto state_hash = world->compute_state_hash();
+            if (threads == 1u)
+            {
+                serial_tick_us = tick_us;
+                serial_movement_us = movement_us;
+                serial_collision_us = collision_us;
+                serial_broadphase_us = broadphase_us;
+                serial_hash = state_hash;
+            }
+
+            report.push_back({
+                { "threads", job_system.get_thread_count() },
+                { "ticks", total.ticks },
+                { "runs", runs },
+                { "wall_seconds", wall_seconds },
+                { "tick_us", tick_us },
+                { "phase_us_per_tick", {
+                    { "spawn", total.spawn_time * 1e6 / ticks },
+                    { "movement", movement_us },
+                    { "collisions", collision_us },
+                    { "broadphase", broadphase_us }
+                } },
+                { "speedup", {
+                    { "tick", tick_us > 0.0 ? serial_tick_us / tick_us : 0.0 },
+                    { "movement", movement_us > 0.0 ? serial_movement_us / movement_us : 0.0 },
+                    { "collisions", collision_us > 0.0 ? serial_collision_us / collision_us : 0.0 },
+                    { "broadphase", broadphase_us > 0.0 ? serial_broadphase_us / broadphase_us : 0.0 }
+                } },
+                { "dropped_bullets", dropped_bullets },
+                { "state_hash", state_hash },
+                { "hash_matches_serial", state_hash == serial_hash }
+            });
+        }
+        return report;
+    }//!run_stress
+
+    /** @returns Mean wall-clock nanoseconds per call of fn (repeated for at least 0.2 s). */
+    template <typename F>
+    double measure_ns(F&& fn)
+    {
+        using Clock = std::chrono::steady_clock;
+        fn(); // Warm up caches
+
+        uint64_t calls = 0;
+        const auto start = Clock::now();
+        auto elapsed = Clock::duration::zero();
+        while (calls < 5u || elapsed < std::chrono::milliseconds(200))
+        {
+            fn();
+            ++calls;
+            elapsed = Clock::now() - start;
+        }
+        return std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(calls);
+    }//!measure_ns
+
+    /** @brief Compares SIMD kernels with the per-object scalar path and returns the report. */
+    nlohmann::json run_kernel_bench(const uint32_t seed)
+    {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> coordinate(0.f, 1920.f);
+        std::uniform_real_distribution<float> speed(-600.f, 600.f);
+        std::uniform_real_distribution<float> extent(-80.f, 80.f); // Negative sizes occur (tightened bounds)
+
+        constexpr float dt = 1.f / 60.f;
+        const sf::FloatRect query({ 900.f, 500.f }, { 120.f, 80.f });
+
+        nlohmann::json report = nlohmann::json::array();
+        for (const size_t count : { 1000u, 10000u, 100000u })
+        {
+            std::vector<sf::Vector2f> positions(count), velocities(count);
+            std::vector<sf::FloatRect> boxes(count);
+            std::vector<uint8_t> hits(count);
+            for (size_t i = 0; i < count; ++i)
+            {
+                positions[i] = { coordinate(rng), coordinate(rng) };
+                velocities[i] = { speed(rng), speed(rng) };
+                boxes[i] = { { coordinate(rng), coordinate(rng) }, { extent(rng), extent(rng) } };
+            }
+
+            size_t scalar_hits = 0, simd_hits = 0;
+            const auto integrate_scalar = measure_ns([&] {
+                for (size_t i = 0; i < count; ++i) positions[i] += velocities[i] * dt;
+            });
+            const auto integrate_simd = measure_ns([&] {
+                flev::simd::integrate(positions, velocities, dt);
+            });
+            const auto overlap_scalar = measure_ns([&] {
+                scalar_hits = 0;
+                for (size_t i = 0; i < count; ++i)
+                {
+                    hits[i] = boxes[i].findIntersection(query) ? 1u : 0u;
+                    scalar_hits += hits[i];
+                }
+            });
+            const auto overlap_simd = measure_ns([&] {
+                simd_hits = flev::simd::overlap_mask(query, boxes, hits);
+            });
+
+            report.push_back({
+                { "entities", count },
+                { "integrate_scalar_ns", integrate_scalar },
+                { "integrate_simd_ns", integrate_simd },
+                { "integrate_speedup", integrate_scalar / integrate_simd },
+                { "overlap_scalar_ns", overlap_scalar },
+                { "overlap_simd_ns", overlap_simd },
+                { "overlap_speedup", overlap_scalar / overlap_simd },
+                { "hits_match", scalar_hits == simd_hits },
+                { "checksum", positions.front().x + positions.back().y } // Keeps the integration loops alive
+            });
+        }
+        return report;
+    }//!run_kernel_bench
+
+    /**
+     * @brief Times score upserts (the query Main_window runs on victory) with and without the statement cache.
+     *
+     * The database lives in memory, so the difference is statement compile
+     * cost, not disk syncs.
+     */
+    nlohmann::json run_db_bench(const uint32_t rows)
+    {
+        nlohmann::json report = nlohmann::json::array();
+        double uncached_seconds = 0.0;
+        for (const size_t capacity : { size_t{ 0 }, Database::default_statement_cache_capacity })
+        {
+            Database db(":memory:");
+            if (!db.is_open() || !db.execute_query(
+                "CREATE TABLE scores ("
+                "id INTEGER PRIMARY KEY AUTOINCREMENT, "
+                "player_name TEXT NOT NULL, "
+                "level_id INTEGER NOT NULL, "
+                "score INTEGER NOT NULL, "
+                "UNIQUE(player_name, level_id)"
+                ");"
+            ))
+            {
+                std::cerr << "Failed to create benchmark database.\n";
+                return report;
+            }
+            db.set_statement_cache_capacity(capacity);
+
+            size_t failed = 0;
+            const auto start = std::chrono::steady_clock::now();
+            for (uint32_t i = 0; i < rows; ++i)
+            {
+                const bool success = db.execute_prepared(
+                    "INSERT INTO scores (player_name, level_id, score) "
+                    "VALUES ({}, {}, {}) "
+                    "ON CONFLICT(player_name, level_id) DO UPDATE SET "
+                    "score = MAX(scores.score, excluded.score);",
+                    { "player_" + std::to_string(i % 1000u), static_cast<int32_t>(i % 2u), static_cast<int32_t>(i) }
+                );
+                if (!success) ++failed;
+            }
+            const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            if (capacity == 0u) uncached_seconds = seconds;
+
+            const auto stats = db.get_statement_cache_stats();
+            report.push_back({
+                { "cache_capacity", capacity },
+                { "rows", rows },
+                { "failed", failed },
+                { "seconds", seconds },
+                { "rows_per_second", seconds > 0.0 ? rows / seconds : 0.0 },
+                { "speedup", seconds > 0.0 ? uncached_seconds / seconds : 0.0 },
+                { "cache_hits", stats.hits },
+                { "cache_misses", stats.misses }
+            });
+        }
+        return report;
+    }//!run_db_bench
+}
+
+int main(int argc, char** argv)
+{
+    FLEV_PROFILE_THREAD("bench");
+    const auto options = parse_options(argc, argv);
+
+    // Collision sizes fall back to fallback_texture_size without assets
+    const auto sizes = load_entity_sizes();
+    Job_system job_system(options.threads - 1u);
+
+    nlohmann::json report;
+    if (options.kernels)
+    {
+        report["instruction_set"] = flev::simd::get_instruction_set();
+        report["seed"] = options.seed;
+        report["kernels"] = run_kernel_bench(options.seed);
+    }
+    else if (options.stress)
+    {
+        report["enemies"] = options.stress_enemies;
+        report["bullets"] = options.stress_bullets;
+        report["ticks_per_thread_count"] = options.stress_ticks;
+        report["tick_rate"] = options.tick_rate;
+        report["seed"] = options.seed;
+        report["input"] = options.scripted ? "scripted" : "random";
+        report["assets_found"] = sizes.assets_found;
+        report["hardware_threads"] = std::thread::hardware_concurrency();
+        report["stress"] = run_stress(options, sizes);
+    }
+    else if (options.db)
+    {
+        report["database"] = run_db_bench(std::max(options.db_rows, 1u));
+    }
+    else if (!options.replay_path.empty())
+    {
+        Replay replay;
+        if (!replay.load(options.replay_path))
+        {
+            std::cerr << "Failed to load replay: " << options.replay_path << '\n';
+            return 1;
+        }
+        report["replay"] = options.replay_path;
+        report["tick_rate"] = replay.tick_rate;
+        report["seed"] = replay.seed;
+        report["input"] = "replay";
+        report["assets_found"] = sizes.assets_found;
+        report["threads"] = job_system.get_thread_count();
+        report["levels"] = nlohmann::json::array({ run_replay(replay, sizes, job_system) });
+    }
+    else
+    {
+        report["simulated_seconds"] = options.seconds;
+        report["tick_rate"] = options.tick_rate;
+        report["seed"] = options.seed;
+        report["input"] = options.scripted ? "scripted" : "random";
+        report["assets_found"] = sizes.assets_found;
+        report["threads"] = job_system.get_thread_count();
+
+        report["levels"] = nlohmann::json::array();
+        for (const auto level_id : options.levels)
+        {
+            report["levels"].push_back(run_level(level_id, options, sizes, job_system));
+        }
+    }
+
+    if (!options.trace_path.empty())
+    {
+#if FLEV_PROFILING_ENABLED
+        if (!flev::profiler::dump_chrome_trace(options.trace_path))
+        {
+            std::cerr << "Failed to write trace: " << options.trace_path << '\n';
+        }
+#else
+        std::cerr << "Profiling is compiled out, rebuild with FLEV_ENABLE_PROFILING to use --trace.\n";
+#endif // FLEV_PROFILING_ENABLED
+    }
+
+    if (options.output_path.empty())
+    {
+        std::cout << report.dump(4) << '\n';
+        return 0;
+    }
+
+    std::ofstream file(options.output_path);
+    if (!file.is_open())
+    {
+        std::cerr << "Failed to open output file: " << options.output_path << '\n';
+        return 1;
+    }
+    file << report.dump(4) << '\n';
+    return 0;
+}
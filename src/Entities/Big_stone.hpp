@@ -1,25 +1,20 @@
+#pragma once
 #include "Enemy.hpp"
 
-class Big_stone final : public Enemy
+/** @brief Big stone archetype: 2 HP, falls diagonally. */
+struct Big_stone final
 {
-public:
+    static constexpr Enemy_type type = Enemy_type::Big_stone;
+    static constexpr const char* texture_path = "assets/big_stone.png";
+    static constexpr uint32_t max_hp = 2u;
+    static constexpr int32_t score_value = 2;
+    static constexpr sf::Vector2f velocity = { -250.f, 400.f };
+    static constexpr sf::Vector2f scale = { 0.2f, 0.2f };
 
-    /** @brief Constructs a big stone enemy with 2 HP, scaled down. */
-    Big_stone(sf::Vector2f start_pos) : Enemy("assets/big_stone.png", 2u, start_pos, { -250, 400 })
+    /** @brief Moves big stones of the context row range. */
+    static void update(Enemy_storage& enemies, const Enemy_update_context& context)
     {
-        score_value_ = 2;
-        sprite_->setScale({ 0.2, 0.2 });
-    }//!Big_stone
-
-	/** @brief A tightened bounding box for collision detection. */
-    FLEV_NODISCARD sf::FloatRect get_bounds() const override
-    {
-        auto bounds = sprite_->getGlobalBounds();
-        float marginX = bounds.size.x;
-        float marginY = bounds.size.y * 0.9;
-        return sf::FloatRect(
-            { bounds.position.x + marginX, bounds.position.y + marginY },
-            { bounds.size.x - marginX * 2, bounds.size.y - marginY * 2 }
-        );
-    }//!get_bounds
-};
\ No newline at end of file
+        enemies.integrate(context.dt, context.begin, context.end);
+        enemies.update_bounds(context.begin, context.end);
+    }//!update
+};
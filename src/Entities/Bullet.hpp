@@ -1,33 +1,149 @@
 #pragma once
-#include "Entity.hpp"
+#include "Enemy.hpp"
+#include <utils/simd_kernels.hpp>
 #include <SFML/Graphics.hpp>
+#include <memory_resource>
+#include <vector>
+#include <span>
+#include <algorithm>
+#include <cassert>
 
-/** @brief Projectile fired by units (e.g. player). */
-class Bullet : public Entity
+/** @brief Player projectile parameters. */
+struct Bullet
+{
+    static constexpr const char* texture_path = "assets/bullet.png";
+    static constexpr sf::Vector2f scale = { 0.2f, 0.2f };
+    static constexpr sf::Vector2f velocity = { 800.f, 0.f };
+};
+
+/** @brief Enemy (warrior) projectile parameters. */
+struct Enemy_bullet
+{
+    static constexpr const char* texture_path = "assets/enemy_bullet1.png";
+    static constexpr sf::Vector2f scale = { 0.2f, 0.2f };
+    static constexpr sf::Vector2f velocity = { -600.f, 0.f };
+};
+
+/**
+ * @brief Fixed-capacity struct-of-arrays pool for projectiles of one kind.
+ *
+ * All columns are allocated once in the constructor. Live bullets occupy
+ * rows [0, size()); removal swaps the last live row into the hole, so the
+ * free rows always form the contiguous tail and are recycled by the next
+ * spawn. Firing and expiring bullets never allocates.
+ */
+class Bullet_pool
 {
 public:
-    /** @brief Constructs bullet at start position with given velocity. */
-    Bullet(
-        sf::Vector2f start_pos, 
-        sf::Vector2f velocity, 
-        const std::string& texture_path = "assets/bullet.png",
-        const sf::Vector2f& scale = { 0.2f, 0.2f }
-    )
-        : Entity(texture_path)
-        , velocity_(velocity)
+
+    /**
+     * @brief Constructs pool and allocates all rows.
+     *
+     * @param capacity[in]      - Maximum number of live bullets.
+     * @param resource[in][opt] - Memory of all columns (e.g. the level arena). [Default: heap]
+     */
+    explicit Bullet_pool(const size_t capacity, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : positions_(capacity, resource)
+        , prev_positions_(capacity, resource)
+        , velocities_(capacity, resource)
+        , bounds_(capacity, resource)
     {
-        sprite_->setScale(scale);
-        set_position(start_pos);
-    }//!Bullet
+    }//!Bullet_pool
+
+    /** @returns Number of live bullets. */
+    FLEV_NODISCARD size_t size() const { return size_; }
+
+    /** @returns Maximum number of live bullets. */
+    FLEV_NODISCARD size_t capacity() const { return positions_.size(); }
 
-    /** @brief Updates bullet position based on velocity. */
-    void update(const float dt) override
+    /** @returns Largest number of simultaneously live bullets seen so far. */
+    FLEV_NODISCARD size_t get_high_water_mark() const { return high_water_mark_; }
+
+    /** @returns Number of spawns rejected because the pool was full. */
+    FLEV_NODISCARD size_t get_dropped_count() const { return dropped_count_; }
+
+    /** @returns Centers of live bullets. */
+    FLEV_NODISCARD std::span<const sf::Vector2f> positions() const { return { positions_.data(), size_ }; }
+
+    /** @returns Collision bounds of live bullets (refreshed after movement). */
+    FLEV_NODISCARD std::span<const sf::FloatRect> bounds() const { return { bounds_.data(), size_ }; }
+
+    /** @brief Sets scaled texture size shared by all bullets. */
+    void set_sprite_size(const sf::Vector2f& size) { sprite_size_ = size; }
+
+    /**
+     * @brief Activates a bullet at start position with given velocity.
+     *
+     * @returns false if the pool is full (the shot is dropped).
+     */
+    bool spawn(const sf::Vector2f& position, const sf::Vector2f& velocity)
     {
-        auto pos = get_position();
-        pos += velocity_ * dt;
-        set_position(pos);
+        if (size_ == capacity())
+        {
+            ++dropped_count_;
+            return false;
+        }
+        positions_[size_] = position;
+        prev_positions_[size_] = position;
+        velocities_[size_] = velocity;
+        bounds_[size_] = compute_sprite_bounds(position, sprite_size_);
+        high_water_mark_ = std::max(high_water_mark_, ++size_);
+        return true;
+    }//!spawn
+
+    /** @brief Releases bullet i by moving the last live bullet into its place. */
+    void swap_remove(const size_t i)
+    {
+        assert(i < size_ && "Bullet index out of range");
+        --size_;
+        positions_[i] = positions_[size_];
+        prev_positions_[i] = prev_positions_[size_];
+        velocities_[i] = velocities_[size_];
+        bounds_[i] = bounds_[size_];
+    }//!swap_remove
+
+    /** @brief Remembers current positions as the previous simulation state. */
+    void save_previous_positions()
+    {
+        std::copy_n(positions_.begin(), size_, prev_positions_.begin());
+    }//!save_previous_positions
+
+    /** @returns Render position of bullet i blended between previous and current state. */
+    FLEV_NODISCARD sf::Vector2f get_interpolated_position(const size_t i, const float alpha) const
+    {
+        return prev_positions_[i] + (positions_[i] - prev_positions_[i]) * alpha;
+    }//!get_interpolated_position
+
+    /** @brief Moves live bullets [begin, end) along their velocity and refreshes their bounds. */
+    void update(const float dt, const size_t begin, const size_t end)
+    {
+        flev::simd::integrate({ positions_.data() + begin, end - begin }, { velocities_.data() + begin, end - begin }, dt);
+        for (size_t i = begin; i < end; ++i)
+        {
+            bounds_[i] = compute_sprite_bounds(positions_[i], sprite_size_);
+        }
     }//!update
 
+    /** @brief Checks if bullet i is outside the screen bounds. */
+    FLEV_NODISCARD bool is_out_of_bounds(const size_t i, const sf::Vector2u& screen_size) const
+    {
+        const auto& box = bounds_[i];
+        return (box.position.x < 0 || box.position.x > screen_size.x) ||
+               (box.position.y < 0 || box.position.y > screen_size.y);
+    }//!is_out_of_bounds
+
+    /** @brief Releases all bullets (statistics are kept). */
+    void clear() { size_ = 0; }
+
 private:
-	sf::Vector2f velocity_; ///< Velocity of the bullet.
-};//!class Bullet
\ No newline at end of file
+
+    std::pmr::vector<sf::Vector2f> positions_;      ///< Sprite centers (capacity rows).
+    std::pmr::vector<sf::Vector2f> prev_positions_; ///< Sprite centers before the last tick (capacity rows).
+    std::pmr::vector<sf::Vector2f> velocities_;     ///< Movement velocities (capacity rows).
+    std::pmr::vector<sf::FloatRect> bounds_;        ///< Collision bounds (capacity rows).
+
+    sf::Vector2f sprite_size_;                      ///< Scaled texture size, shared by all bullets.
+    size_t size_ = 0;                               ///< Number of live bullets.
+    size_t high_water_mark_ = 0;                    ///< Peak number of live bullets.
+    size_t dropped_count_ = 0;                      ///< Rejected spawns.
+};
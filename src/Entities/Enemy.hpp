@@ -1,37 +1,211 @@
 #pragma once
-#include "Unit.hpp"
+#include "Entity.hpp"
+#include <utils/defines.hpp>
+#include <utils/simd_kernels.hpp>
 #include <SFML/Graphics.hpp>
+#include <array>
+#include <memory_resource>
+#include <span>
+#include <vector>
+#include <cstdint>
 
-class Enemy : public Unit
+/** @brief Enemy archetypes. Value is the index of the archetype storage. */
+enum class Enemy_type : uint8_t
 {
-public:
-    Enemy(const std::string& texture_path, uint32_t max_hp, sf::Vector2f start_pos, sf::Vector2f velocity)
-        : Unit(texture_path, max_hp)
-        , velocity_(velocity)
-    {
-        set_position(start_pos);
-    }//!Enemy
-
-    using Unit::update;
-    void update(const float dt) override
-    {
-        auto pos = get_position();
-        pos += velocity_ * dt;
-        set_position(pos);
-    }//!update
-     
-    /** @brief Checks if the enemy is out of the left screen bounds. */
-    FLEV_NODISCARD bool is_out_of_bounds(const sf::Vector2u& screen_size) const override
-    {
-		const auto bounds = get_bounds();
-        return (bounds.position.x + bounds.size.x < 0);
+    Big_stone,
+    Small_stone,
+    Scout,
+    Warrior,
+
+    Count
+};
+
+/** @brief Number of enemy archetypes. */
+constexpr size_t enemy_type_count = static_cast<size_t>(Enemy_type::Count);
+
+/** @returns Storage index of the given archetype. */
+constexpr size_t to_index(const Enemy_type type) { return static_cast<size_t>(type); }
+
+/**
+ * @brief Default collision box margins per archetype (indexed by Enemy_type).
+ *
+ * Used until Game_world::set_enemy_mask() replaces them with the solid area
+ * of the texture. Stones are drawn with transparent padding around the rock,
+ * so their box is trimmed; ships collide with the full sprite.
+ */
+constexpr std::array<Hitbox_margins, enemy_type_count> enemy_hitbox_margins = {{
+    { 0.f, 0.1f, 0.f, 0.1f },         // Big_stone
+    { 0.35f, 0.4f, 0.35f, 0.4f },     // Small_stone
+    {},                               // Scout
+    {},                               // Warrior
+}};
+
+/**
+ * @brief Struct-of-arrays storage for all enemies of one archetype.
+ *
+ * Row i of every column describes the same enemy. Removal swaps the last
+ * row into the hole, so order is not preserved but arrays stay dense.
+ * Behaviour columns (phase, timer, anchor) are interpreted by the archetype.
+ */
+struct Enemy_storage
+{
+    // Common state
+    std::pmr::vector<sf::Vector2f> positions;      ///< Sprite center.
+    std::pmr::vector<sf::Vector2f> prev_positions; ///< Sprite center before the last tick (for interpolation).
+    std::pmr::vector<sf::Vector2f> velocities;     ///< Movement velocity.
+    std::pmr::vector<uint32_t> hp;                 ///< Current health points.
+    std::pmr::vector<int32_t> score_values;        ///< Score awarded when destroyed.
+    std::pmr::vector<sf::FloatRect> bounds;        ///< Collision bounds (refreshed after movement).
+    std::pmr::vector<float> rotations;             ///< Sprite rotation in degrees.
+
+    // Behaviour state
+    std::pmr::vector<uint8_t> phases;              ///< Archetype specific state machine value.
+    std::pmr::vector<float> timers;                ///< Archetype specific timer (seconds).
+    std::pmr::vector<sf::Vector2f> anchors;        ///< Archetype specific anchor point.
+
+    sf::Vector2f sprite_size;                      ///< Scaled texture size, shared by the archetype.
+    Hitbox_margins hitbox;                         ///< Collision box margins, shared by the archetype.
+
+    /** @brief Constructs empty storage on the default memory resource. */
+    Enemy_storage() = default;
+
+    /**
+     * @brief Constructs empty storage on the given memory resource.
+     *
+     * @param resource[in] - Memory of all columns (e.g. the level arena).
+     */
+    explicit Enemy_storage(std::pmr::memory_resource* resource)
+        : positions(resource)
+        , prev_positions(resource)
+        , velocities(resource)
+        , hp(resource)
+        , score_values(resource)
+        , bounds(resource)
+        , rotations(resource)
+        , phases(resource)
+        , timers(resource)
+        , anchors(resource)
+    {
+    }//!Enemy_storage
+
+    /** @returns Number of enemies. */
+    FLEV_NODISCARD size_t size() const { return positions.size(); }
+
+    /** @returns true if there are no enemies. */
+    FLEV_NODISCARD bool empty() const { return positions.empty(); }
+
+    /** @brief Appends an enemy of archetype T at the given position. */
+    template <typename T>
+    void spawn(const sf::Vector2f& position)
+    {
+        positions.push_back(position);
+        prev_positions.push_back(position);
+        velocities.push_back(T::velocity);
+        hp.push_back(T::max_hp);
+        score_values.push_back(T::score_value);
+        bounds.push_back(apply_hitbox_margins(compute_sprite_bounds(position, sprite_size), hitbox));
+        rotations.push_back(0.f);
+        phases.push_back(0u);
+        timers.push_back(0.f);
+        anchors.push_back({});
+    }//!spawn
+
+    /** @brief Removes enemy i by moving the last enemy into its place. */
+    void swap_remove(const size_t i)
+    {
+        const auto swap_pop = [i](auto& column) {
+            column[i] = column.back();
+            column.pop_back();
+        };
+        swap_pop(positions);
+        swap_pop(prev_positions);
+        swap_pop(velocities);
+        swap_pop(hp);
+        swap_pop(score_values);
+        swap_pop(bounds);
+        swap_pop(rotations);
+        swap_pop(phases);
+        swap_pop(timers);
+        swap_pop(anchors);
+    }//!swap_remove
+
+    /** @brief Remembers current positions as the previous simulation state. */
+    void save_previous_positions()
+    {
+        prev_positions.assign(positions.begin(), positions.end());
+    }//!save_previous_positions
+
+    /** @returns Render position of enemy i blended between previous and current state. */
+    FLEV_NODISCARD sf::Vector2f get_interpolated_position(const size_t i, const float alpha) const
+    {
+        return prev_positions[i] + (positions[i] - prev_positions[i]) * alpha;
+    }//!get_interpolated_position
+
+    /** @brief Moves enemies [begin, end) along their velocity. */
+    void integrate(const float dt, const size_t begin, const size_t end)
+    {
+        flev::simd::integrate(
+            std::span(positions).subspan(begin, end - begin),
+            std::span<const sf::Vector2f>(velocities).subspan(begin, end - begin),
+            dt
+        );
+    }//!integrate
+
+    /**
+     * @brief Refreshes collision bounds of enemies [begin, end) from the archetype margins.
+     *
+     * Archetypes call this once per tick after moving, so every collision
+     * pass reads the same contiguous bounds column instead of recomputing.
+     */
+    void update_bounds(const size_t begin, const size_t end)
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            bounds[i] = apply_hitbox_margins(compute_sprite_bounds(positions[i], sprite_size, rotations[i]), hitbox, rotations[i]);
+        }
+    }//!update_bounds
+
+    /** @brief Applies damage to enemy i and returns true if it is destroyed. */
+    bool take_damage(const size_t i, const uint32_t damage)
+    {
+        if (damage == 0u) return false;
+        hp[i] = hp[i] > damage ? hp[i] - damage : 0u;
+        return hp[i] == 0u;
+    }//!take_damage
+
+    /** @brief Checks if enemy i is out of the left screen bounds. */
+    FLEV_NODISCARD bool is_out_of_bounds(const size_t i) const
+    {
+        return (bounds[i].position.x + bounds[i].size.x < 0);
     }//!is_out_of_bounds
 
-    /** @brief Score awarded to player when this enemy is destroyed. */
-    FLEV_NODISCARD virtual int32_t get_score_value() const { return score_value_; }
+    /** @brief Removes all enemies. */
+    void clear()
+    {
+        positions.clear();
+        prev_positions.clear();
+        velocities.clear();
+        hp.clear();
+        score_values.clear();
+        bounds.clear();
+        rotations.clear();
+        phases.clear();
+        timers.clear();
+        anchors.clear();
+    }//!clear
+};
 
-protected:
-    
-	int32_t score_value_ = 1; ///< Score awarded when destroyed.
-	sf::Vector2f velocity_;   ///< Movement velocity.
-};
\ No newline at end of file
+/**
+ * @brief Per-tick inputs of an archetype update (same signature for every archetype).
+ *
+ * An update only touches rows [begin, end), so disjoint ranges of one
+ * storage can be updated on different threads.
+ */
+struct Enemy_update_context
+{
+    float dt = 0.f;                      ///< Tick duration in seconds.
+    sf::Vector2u screen_size;            ///< Playfield size in pixels.
+    std::pmr::vector<size_t>& shooters;  ///< Receives rows of enemies that fire this tick (in row order, capacity reserved).
+    size_t begin = 0;                    ///< First row to update.
+    size_t end = 0;                      ///< One past the last row to update.
+};
@@ -0,0 +1,55 @@
+#pragma once
+#include "Big_stone.hpp"
+#include "Small_stone.hpp"
+#include "Scout.hpp"
+#include "Warrior.hpp"
+#include <concepts>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+/** @brief Static interface every enemy archetype provides (no virtual dispatch). */
+template <typename T>
+concept Enemy_archetype = requires(Enemy_storage& enemies, const Enemy_update_context& context)
+{
+    { T::type } -> std::convertible_to<Enemy_type>;
+    { T::texture_path } -> std::convertible_to<const char*>;
+    { T::scale } -> std::convertible_to<sf::Vector2f>;
+    T::update(enemies, context);
+};
+
+/** @brief All enemy archetypes, in Enemy_type order. */
+using Enemy_archetypes = std::tuple<Big_stone, Small_stone, Scout, Warrior>;
+
+/**
+ * @brief Calls fn once per archetype with std::type_identity<T> (in Enemy_type order).
+ *
+ * The calls are unrolled at compile time, so each archetype's code inlines
+ * into its own homogeneous loop:
+ *
+ *     for_each_enemy_archetype([&]<typename T>(std::type_identity<T>) { T::update(storage, context); });
+ */
+template <typename F>
+void for_each_enemy_archetype(F&& fn)
+{
+    [&]<size_t... I>(std::index_sequence<I...>) {
+        (fn(std::type_identity<std::tuple_element_t<I, Enemy_archetypes>>{}), ...);
+    }(std::make_index_sequence<std::tuple_size_v<Enemy_archetypes>>{});
+}//!for_each_enemy_archetype
+
+namespace enemy_archetypes_detail
+{
+    /** @returns true if every archetype satisfies the interface and sits at its Enemy_type index. */
+    template <size_t... I>
+    consteval bool is_valid_list(std::index_sequence<I...>)
+    {
+        return ((Enemy_archetype<std::tuple_element_t<I, Enemy_archetypes>>
+            && to_index(std::tuple_element_t<I, Enemy_archetypes>::type) == I) && ...);
+    }//!is_valid_list
+}
+
+static_assert(std::tuple_size_v<Enemy_archetypes> == enemy_type_count, "Every Enemy_type needs an archetype.");
+static_assert(
+    enemy_archetypes_detail::is_valid_list(std::make_index_sequence<enemy_type_count>{}),
+    "Enemy_archetypes must list archetypes in Enemy_type order."
+);
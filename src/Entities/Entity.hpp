@@ -1,52 +1,132 @@
 #pragma once
 #include <utils/defines.hpp>
-#include <utils/logger.hpp>
 #include <SFML/Graphics.hpp>
-#include <map>
+#include <cmath>
 
-/** @brief Base class for all in-game entities (player, enemies, etc.). */
+/**
+ * @brief Axis-aligned bounds of a centered sprite of the given size.
+ *
+ * Matches sf::Sprite::getGlobalBounds() for a sprite with origin in its center.
+ */
+inline sf::FloatRect compute_sprite_bounds(
+    const sf::Vector2f& position,
+    const sf::Vector2f& size,
+    const float rotation_deg = 0.f
+)
+{
+    sf::Vector2f extent = size;
+    if (rotation_deg != 0.f)
+    {
+        const float rad = rotation_deg * 3.1415926535f / 180.f; // PI
+        const float c = std::abs(std::cos(rad));
+        const float s = std::abs(std::sin(rad));
+        extent = { size.x * c + size.y * s, size.x * s + size.y * c };
+    }
+    return sf::FloatRect(position - extent / 2.f, extent);
+}//!compute_sprite_bounds
+
+/** @brief Collision box inset of a sprite, per side, as a fraction of the sprite size. */
+struct Hitbox_margins
+{
+    float left = 0.f;   ///< Trimmed from the left edge.
+    float top = 0.f;    ///< Trimmed from the top edge.
+    float right = 0.f;  ///< Trimmed from the right edge.
+    float bottom = 0.f; ///< Trimmed from the bottom edge.
+};
+
+/** @returns true if a sprite with the given rotation is its unrotated image turned upside down. */
+inline bool is_half_turn(const float rotation_deg)
+{
+    return std::abs(rotation_deg) == 180.f;
+}//!is_half_turn
+
+/**
+ * @brief Collision box of a sprite with the given bounds and margins.
+ *
+ * Margins describe the unrotated sprite. A half turn swaps opposite sides;
+ * other rotations apply them to the rotated bounding box as they are.
+ */
+inline sf::FloatRect apply_hitbox_margins(
+    const sf::FloatRect& sprite_bounds,
+    const Hitbox_margins& margins,
+    const float rotation_deg = 0.f
+)
+{
+    const Hitbox_margins m = is_half_turn(rotation_deg)
+        ? Hitbox_margins{ margins.right, margins.bottom, margins.left, margins.top }
+        : margins;
+    const auto& size = sprite_bounds.size;
+    return sf::FloatRect(
+        { sprite_bounds.position.x + size.x * m.left, sprite_bounds.position.y + size.y * m.top },
+        { size.x * (1.f - m.left - m.right), size.y * (1.f - m.top - m.bottom) }
+    );
+}//!apply_hitbox_margins
+
+/**
+ * @brief Base class for standalone in-game entities (player).
+ *
+ * Holds simulation state only: the entity is a centered box of the scaled
+ * texture size. Sprites are owned by the scene, so entities can be simulated
+ * without a window or GPU textures.
+ */
 class Entity
 {
 public:
-    /** @brief Constructs entity and loads its texture (cached per path). */
-    Entity(const std::string& texture_path)
-    {
-        TODO("Move into future resourse manager")
-        static std::map<std::string, sf::Texture> textures;
-
-        if (!textures.contains(texture_path))
-        {
-            if (!textures[texture_path].loadFromFile(texture_path))
-            {
-                LOG_ERROR(
-                    get_global_logger(),
-                    "Failed to load texture from path: {}",
-                    texture_path
-				);
-                textures.erase(texture_path);
-            }
-        }
-        sprite_ = std::make_unique<sf::Sprite>(textures.at(texture_path));
-        sprite_->setOrigin(sprite_->getLocalBounds().getCenter());
+    /** @brief Constructs entity with the given scaled sprite size and collision margins. */
+    explicit Entity(const sf::Vector2f& size = {}, const Hitbox_margins& hitbox = {})
+        : size_(size)
+        , hitbox_(hitbox)
+    {
+        refresh_bounds();
     }//!Entity
 
     virtual ~Entity() = default;
 
-    /** @brief Updates entity logic (to be implemented by derived classes). */
-    virtual void update(const float dt) = 0;
-    virtual void update(const float dt, const sf::Vector2u& screen_size) { update(dt); };
+    /** @brief Remembers current position as the previous simulation state. */
+    void save_previous_position() { prev_position_ = position_; }
 
-    /** @brief Draws the entity sprite to the given target. */
-    virtual void draw(sf::RenderTarget& render_target) const { render_target.draw(*sprite_); }
+    /** @returns Render position blended between previous and current tick. */
+    FLEV_NODISCARD sf::Vector2f get_interpolated_position(const float alpha) const
+    {
+        return prev_position_ + (position_ - prev_position_) * alpha;
+    }//!get_interpolated_position
 
-    /** @returns The global bounding rectangle of the entity. */
-    virtual FLEV_NODISCARD sf::FloatRect get_bounds() const { return sprite_->getGlobalBounds(); }
+    /** @returns Collision box (cached, refreshed whenever position or size changes). */
+    FLEV_NODISCARD const sf::FloatRect& get_bounds() const { return bounds_; }
 
-    /** @returns Current position of the entity. */
-    virtual FLEV_NODISCARD sf::Vector2f get_position() const { return sprite_->getPosition(); }
+    /** @returns Current position (center) of the entity. */
+    virtual FLEV_NODISCARD sf::Vector2f get_position() const { return position_; }
 
-    /** @brief Sets the entity's position. */
-    virtual void set_position(const sf::Vector2f& position) { sprite_->setPosition(position); }
+    /** @brief Sets the entity's position (center). */
+    virtual void set_position(const sf::Vector2f& position)
+    {
+        position_ = position;
+        refresh_bounds();
+    }//!set_position
+
+    /** @returns Scaled sprite size. */
+    FLEV_NODISCARD sf::Vector2f get_size() const { return size_; }
+
+    /** @brief Sets scaled sprite size (texture size multiplied by sprite scale). */
+    void set_size(const sf::Vector2f& size)
+    {
+        size_ = size;
+        refresh_bounds();
+    }//!set_size
+
+    /** @brief Sets collision box margins. */
+    void set_hitbox(const Hitbox_margins& hitbox)
+    {
+        hitbox_ = hitbox;
+        refresh_bounds();
+    }//!set_hitbox
+
+    /** @brief Moves the entity without interpolating from the old position. */
+    void teleport(const sf::Vector2f& position)
+    {
+        set_position(position);
+        save_previous_position();
+    }//!teleport
 
     /** @brief Checks if the entity is outside the screen bounds. */
     virtual FLEV_NODISCARD bool is_out_of_bounds(const sf::Vector2u& screen_size) const
@@ -57,5 +137,13 @@ public:
     }//!is_out_of_bounds
 
 protected:
-    std::unique_ptr<sf::Sprite> sprite_; ///< Sprite representing the entity.
+
+    /** @brief Recomputes the cached collision box. */
+    void refresh_bounds() { bounds_ = apply_hitbox_margins(compute_sprite_bounds(position_, size_), hitbox_); }
+
+    sf::Vector2f position_;      ///< Sprite center.
+    sf::Vector2f prev_position_; ///< Position before the last tick (for interpolation).
+    sf::Vector2f size_;          ///< Scaled sprite size.
+    Hitbox_margins hitbox_;      ///< Collision box inset.
+    sf::FloatRect bounds_;       ///< Cached collision box.
 };
\ No newline at end of file
@@ -1,20 +1,30 @@
 #pragma once
 #include "Unit.hpp"
+#include <utils/sim_clock.hpp>
 #include <SFML/Graphics.hpp>
 
+/** @brief Player controls sampled once per tick (keyboard, script or replay). */
+struct Player_input
+{
+    bool up = false;    ///< Move up.
+    bool down = false;  ///< Move down.
+    bool left = false;  ///< Move left.
+    bool right = false; ///< Move right.
+    bool shoot = false; ///< Fire (limited by attack cooldown).
+};
+
 class Player final : public Unit
 {
 public:
+    static constexpr const char* texture_path = "assets/player.png";
+    static constexpr sf::Vector2f scale = { 0.2f, 0.2f };
+    static constexpr Hitbox_margins hitbox = { 0.1f, 0.375f, 0.1f, 0.125f }; ///< Default margins (wings and exhaust), replaced by the texture mask.
 
-	/** @brief Constructs player with default texture and 3 HP. */
-    Player();
-
-    /** @brief Required override; forwards to the version with screen_size. */
-    void update(const float dt) override;
-
-	/** @brief Updates player logic (movement, shooting) with screen size. */
-    void update(const float dt, const sf::Vector2u& screen_size) override;
+	/** @brief Constructs player with 3 HP, timed by the given simulation clock. */
+    explicit Player(const Sim_clock& clock);
 
+	/** @brief Updates player logic (movement, shooting) from the input of this tick. */
+    void update(const float dt, const sf::Vector2u& screen_size, const Player_input& input);
 
     /** @brief Checks if player has requested a shot (and consumes the flag). */
     FLEV_NODISCARD bool is_need_to_shoot();
@@ -25,11 +35,8 @@ public:
 	/** @returns The player's movement speed. */
     FLEV_NODISCARD float get_speed() const;
 
-	/** @returns A tightened bounding box for collision detection. */
-    FLEV_NODISCARD sf::FloatRect get_bounds() const override;
-
 private:
-	sf::Clock shoot_clock_;                  ///< Clock to manage shooting cooldown.
+	Sim_timer shoot_clock_;                  ///< Timer to manage shooting cooldown.
 	float speed_ = 300.f;                    ///< Movement speed in pixels per second.
 	float attack_cooldown_ = 0.7f;           ///< Time between shots in seconds.
 	std::atomic_bool need_to_shoot_ = false; ///< Flag indicating if a shot is requested.
@@ -1,100 +1,103 @@
+#pragma once
 #include "Enemy.hpp"
+#include <utils/logger.hpp>
+#include <cassert>
+#include <mutex>
 
-class Scout final : public Enemy
+/** @brief Scout archetype: flies left, makes a U-turn and leaves to the right. */
+struct Scout final
 {
-public:
+    static constexpr Enemy_type type = Enemy_type::Scout;
+    static constexpr const char* texture_path = "assets/enemy_scout.png";
+    static constexpr uint32_t max_hp = 2u;
+    static constexpr int32_t score_value = 1;
+    static constexpr sf::Vector2f velocity = { -400.f, 0.f };
+    static constexpr sf::Vector2f scale = { 0.2f, 0.2f };
 
-	/** @brief Constructs a small stone enemy with 1 HP, scaled down. */
-    Scout(const sf::Vector2f& start_pos) : Enemy("assets/enemy_scout.png ", 2u, start_pos, {-400.f, 0.f})
-	{
-		sprite_->setScale({ 0.2, 0.2 });
-	}//!Small_stone
-
-    /** @brief Required override; forwards to the version with screen_size. */
-    void update(const float dt) override
+    /** @brief Movement direction (stored in Enemy_storage::phases). */
+    enum class Direction : uint8_t
     {
-        assert(false && "Scout::update(dt) called without screen_size! Use update(dt, screen_size) instead.");	
-        
-        // Fallback for releases builds
-        update(dt, { 800u, 600u });
-    }//!update
+		Left,   ///< Moving leftwards.
+		Right,  ///< Moving rightwards.
+		Turning ///< Currently performing a turn maneuver.
+    };
 
-    /** @brief Updates scout logic (movement) with screen size. */
-	void update(const float dt, const sf::Vector2u& screen_size) override
+    /**
+     * @brief Updates movement of scouts in the context row range.
+     *
+     * Uses Enemy_storage::timers as turn timer and Enemy_storage::anchors as turn start position.
+     */
+	static void update(Enemy_storage& enemies, const Enemy_update_context& context)
 	{
         using enum Direction;
-        auto pos = get_position();
-
-        switch (direction_)
+        const float dt = context.dt;
+        const auto& screen_size = context.screen_size;
+        for (size_t i = context.begin; i < context.end; ++i)
         {
-        case Right:
-        {
-            pos.x += velocity_.x * dt;
-            break;
-        }
-        case Left:
-        {
-            pos.x += velocity_.x * dt;
-            if (pos.x <= 300.f)
+            auto& pos = enemies.positions[i];
+            auto& velocity = enemies.velocities[i];
+            auto& turn_timer = enemies.timers[i];
+            auto& start_turn_pos = enemies.anchors[i];
+
+            switch (static_cast<Direction>(enemies.phases[i]))
             {
-                direction_ = Turning;
-                turn_timer_ = 0.f;
-                start_turn_pos_ = pos;
+            case Right:
+            {
+                pos.x += velocity.x * dt;
+                break;
             }
-            break;
-        }
+            case Left:
+            {
+                pos.x += velocity.x * dt;
+                if (pos.x <= 300.f)
+                {
+                    enemies.phases[i] = static_cast<uint8_t>(Turning);
+                    turn_timer = 0.f;
+                    start_turn_pos = pos;
+                }
+                break;
+            }
+            case Turning:
+            {
+                const bool turn_downward = (start_turn_pos.y < screen_size.y / 2.f);
+                turn_timer += dt;
+                const float time = std::min(turn_timer / turn_duration_, 1.0f);
 
-        case Turning:
-        {
-            const bool turn_downward_ = (start_turn_pos_.y < screen_size.y / 2.f);
-            turn_timer_ += dt;
-            const float time = std::min(turn_timer_ / turn_duration_, 1.0f);
-            
-            const auto angle = 180.f * time;
-            sprite_->setRotation(sf::degrees(turn_downward_ ? -angle : angle));
+                const auto angle = 180.f * time;
+                enemies.rotations[i] = turn_downward ? -angle : angle;
 
-            const auto end_y = turn_downward_
-                ? start_turn_pos_.y + turn_radius_ * 2 
-                : start_turn_pos_.y - turn_radius_ * 2;
-            pos.y = start_turn_pos_.y + (end_y - start_turn_pos_.y) * time;
+                const auto end_y = turn_downward
+                    ? start_turn_pos.y + turn_radius_ * 2
+                    : start_turn_pos.y - turn_radius_ * 2;
+                pos.y = start_turn_pos.y + (end_y - start_turn_pos.y) * time;
 
-            const float x_offset = turn_radius_ * std::sin(time * 3.1415926535f); // PI 
-            pos.x = start_turn_pos_.x - x_offset;
+                const float x_offset = turn_radius_ * std::sin(time * 3.1415926535f); // PI
+                pos.x = start_turn_pos.x - x_offset;
 
-            if (time >= 1.0f)
-            {
-				velocity_.x = std::abs(velocity_.x) + 100.f; // Speed boost after turn
-                direction_ = Right;
+                if (time >= 1.0f)
+                {
+                    velocity.x = std::abs(velocity.x) + 100.f; // Speed boost after turn
+                    enemies.phases[i] = static_cast<uint8_t>(Right);
+                }
+                break;
             }
-            break;
-        }
-        default:
-        {
-			assert(false && "Scout enemy has invalid movement direction!");
+            default:
+            {
+                assert(false && "Scout enemy has invalid movement direction!");
 
-            std::call_once(invalid_direction_flag_, []() {
-                LOG_ERROR(get_global_logger(), "Scout enemy has invalid movement direction!");
-            });
-            break;
-        }
+                static std::once_flag invalid_direction_flag;
+                std::call_once(invalid_direction_flag, []() {
+                    LOG_ERROR(get_global_logger(), "Scout enemy has invalid movement direction!");
+                });
+                break;
+            }
+            }
         }
-        set_position(pos);
+        enemies.update_bounds(context.begin, context.end);
 	}//!update
 
 private:
 
 	static constexpr float turn_duration_ = 1.0f; ///< Duration of the turn maneuver in seconds.
 	static constexpr float turn_radius_ = 100.f;  ///< Radius of the turn maneuver.
-
-	std::once_flag invalid_direction_flag_;       ///< Flag to ensure invalid direction logging happens only once.
-
-    enum class Direction
-    {
-		Left,   ///< Moving leftwards.
-		Right,  ///< Moving rightwards.
-		Turning ///< Currently performing a turn maneuver.
-
-    } direction_ = Direction::Left;               ///< Current movement direction.
-    sf::Vector2f start_turn_pos_{};               ///< Position where the turn started.
-	float turn_timer_ = 0.f;                      ///< Timer for the turn maneuver.
-};
\ No newline at end of file
+};
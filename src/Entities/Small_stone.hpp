@@ -1,24 +1,20 @@
+#pragma once
 #include "Enemy.hpp"
 
-class Small_stone final : public Enemy
+/** @brief Small stone archetype: 1 HP, falls diagonally. */
+struct Small_stone final
 {
-public:
+    static constexpr Enemy_type type = Enemy_type::Small_stone;
+    static constexpr const char* texture_path = "assets/small_stone.png";
+    static constexpr uint32_t max_hp = 1u;
+    static constexpr int32_t score_value = 1;
+    static constexpr sf::Vector2f velocity = { -450.f, 200.f };
+    static constexpr sf::Vector2f scale = { 0.5f, 0.5f };
 
-	/** @brief Constructs a small stone enemy with 1 HP, scaled down. */
-	Small_stone(sf::Vector2f start_pos): Enemy("assets/small_stone.png", 1u, start_pos, {-450, 200})
-	{
-		sprite_->setScale({ 0.5, 0.5 });
-	}//!Small_stone
-
-	/** @brief A tightened bounding box for collision detection. */
-	FLEV_NODISCARD sf::FloatRect get_bounds() const override
-	{
-		auto bounds = sprite_->getGlobalBounds();
-		float marginX = bounds.size.x * 0.35f;
-		float marginY = bounds.size.y * 0.4f;
-		return sf::FloatRect(
-			{ bounds.position.x + marginX, bounds.position.y + marginY },
-			{ bounds.size.x - marginX * 2, bounds.size.y - marginY * 2 }
-		);
-	}//!get_bounds
-};
\ No newline at end of file
+    /** @brief Moves small stones of the context row range. */
+    static void update(Enemy_storage& enemies, const Enemy_update_context& context)
+    {
+        enemies.integrate(context.dt, context.begin, context.end);
+        enemies.update_bounds(context.begin, context.end);
+    }//!update
+};
@@ -7,8 +7,8 @@
 class Unit : public Entity
 {
 public:
-    Unit(const std::string& texture_path, uint32_t max_hp)
-        : Entity(texture_path)
+    Unit(uint32_t max_hp, const Hitbox_margins& hitbox = {})
+        : Entity({}, hitbox)
         , max_hp_(max_hp)
         , current_hp_(max_hp)
     {
@@ -1,90 +1,89 @@
+#pragma once
 #include "Enemy.hpp"
+#include <limits>
 
-class Warrior final : public Enemy
+/** @brief Warrior archetype: stops near the right edge, shoots once and leaves. */
+struct Warrior final
 {
-public:
+    static constexpr Enemy_type type = Enemy_type::Warrior;
+    static constexpr const char* texture_path = "assets/enemy_warrior.png";
+    static constexpr uint32_t max_hp = 2u;
+    static constexpr int32_t score_value = 2;
+    static constexpr sf::Vector2f velocity = { -250.f, 0.f };
+    static constexpr sf::Vector2f scale = { 0.2f, 0.2f };
 
-    /** @brief Constructs a shooting warrior enemy with 2 HP. */
-    Warrior(const sf::Vector2f& start_pos) 
-        : Enemy("assets/enemy_warrior.png ", 2u, start_pos, default_velocity_)
+    /** @brief Behaviour phase (stored in Enemy_storage::phases). */
+    enum class Phase : uint8_t
     {
-        score_value_ = 2;
-        sprite_->setScale({ 0.2, 0.2 });
-    }//!Warrior
+        Approaching, ///< Has not shot yet.
+        Leaving      ///< Has shot, waits and flies away.
+    };
 
-    /** @brief Checks if unit has requested a shot (and consumes the flag). */
-    FLEV_NODISCARD bool is_need_to_shoot()
+	/**
+     * @brief Updates movement and shooting of warriors in the context row range.
+     *
+     * Uses Enemy_storage::timers as sleep timer. Rows of warriors that fire
+     * this tick are appended to context.shooters.
+     */
+    static void update(Enemy_storage& enemies, const Enemy_update_context& context)
     {
-        if (need_to_shoot_) is_shoot_ = true;
-        return need_to_shoot_.exchange(false);
-    }//!is_need_to_shoot
-
-    /** @brief Required override; forwards to the version with screen_size. */
-    void update(const float dt) override
-    {
-        assert(false && "Warrior::update(dt) called without screen_size! Use update(dt, screen_size) instead.");
-
-        // Fallback for releases builds
-        update(dt, { 800u, 600u });
-    }//!update
-
-	/** @brief Updates warrior logic (movement, shooting) with screen size. */
-    void update(const float dt, const sf::Vector2u& screen_size) override
-    {
-        auto pos = get_position();
-
-		// If we already shoot - wait sleep time and move to out of screen
-        if (is_shoot_)
+        const float dt = context.dt;
+        const auto& screen_size = context.screen_size;
+        for (size_t i = context.begin; i < context.end; ++i)
         {
-            if (std::abs(velocity_.x) > std::numeric_limits<float>::epsilon())
-            {
-                pos += velocity_ * dt;
-            }
-            else
-            {
-                sleep_timer_ += dt;
-                if (sleep_timer_ >= sleep_time_)
-                {
-                    velocity_ = default_velocity_; // Resume moving left
-                    velocity_.y = 150.f; // Start moving vertically
-                    if (pos.y < screen_size.y / 2.f) velocity_.y = -velocity_.y;
-                    sleep_timer_ = 0.f;
-                }
-            }
-        }
-        else // Move left until 80% of screen width, then stop
-        {
-            if (std::abs(velocity_.x) > std::numeric_limits<float>::epsilon())
+            auto& pos = enemies.positions[i];
+            auto& velocity = enemies.velocities[i];
+            auto& sleep_timer = enemies.timers[i];
+            const bool is_moving = std::abs(velocity.x) > std::numeric_limits<float>::epsilon();
+
+		    // If we already shoot - wait sleep time and move to out of screen
+            if (static_cast<Phase>(enemies.phases[i]) == Phase::Leaving)
             {
-                if (pos.x < screen_size.x * 0.8)
+                if (is_moving)
                 {
-                    velocity_.x = 0.f;
+                    pos += velocity * dt;
                 }
                 else
                 {
-					pos += velocity_ * dt;
+                    sleep_timer += dt;
+                    if (sleep_timer >= sleep_time_)
+                    {
+                        velocity = Warrior::velocity; // Resume moving left
+                        velocity.y = 150.f; // Start moving vertically
+                        if (pos.y < screen_size.y / 2.f) velocity.y = -velocity.y;
+                        sleep_timer = 0.f;
+                    }
                 }
             }
-            else
+            else // Move left until 80% of screen width, then stop
             {
-				sleep_timer_ += dt;
-                if (sleep_timer_ >= sleep_time_)
+                if (is_moving)
                 {
-                    need_to_shoot_ = true;
-					sleep_timer_ = 0.f;
+                    if (pos.x < screen_size.x * 0.8)
+                    {
+                        velocity.x = 0.f;
+                    }
+                    else
+                    {
+					    pos += velocity * dt;
+                    }
+                }
+                else
+                {
+				    sleep_timer += dt;
+                    if (sleep_timer >= sleep_time_)
+                    {
+                        context.shooters.push_back(i);
+                        enemies.phases[i] = static_cast<uint8_t>(Phase::Leaving);
+					    sleep_timer = 0.f;
+                    }
                 }
             }
         }
-
-        set_position(pos);
+        enemies.update_bounds(context.begin, context.end);
     }//!update
 
 private:
 
-	constexpr static sf::Vector2f default_velocity_ = { -250.f, 0.f }; ///< Default leftward velocity.
-	float sleep_timer_ = 0.f;   ///< Timer for sleep before shooting.
-	float sleep_time_ = 1.f;    ///< Time to wait before and after shooting.
-
-	bool is_shoot_ = false;     ///< Flag indicating if the warrior has shot.
-	std::atomic_bool need_to_shoot_ = false; ///< Flag indicating if the warrior needs to shoot.
-};
\ No newline at end of file
+	static constexpr float sleep_time_ = 1.f; ///< Time to wait before and after shooting.
+};
@@ -0,0 +1,755 @@
+#include "Game_world.hpp"
+
+#include <Entities/Enemy_archetypes.hpp>
+
+#include <utils/profiler.hpp>
+#include <utils/simd_kernels.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <span>
+#include <utility>
+
+namespace
+{
+    using Stats_clock = std::chrono::steady_clock;
+
+    /** @returns Seconds elapsed since start and moves start to now. */
+    double lap(Stats_clock::time_point& start)
+    {
+        const auto now = Stats_clock::now();
+        const auto elapsed = std::chrono::duration<double>(now - start).count();
+        start = now;
+        return elapsed;
+    }//!lap
+
+    /** @returns World pixel of the top-left corner of a mask centered at the given position. */
+    sf::Vector2i get_mask_origin(const Collision_mask& mask, const sf::Vector2f& center)
+    {
+        const auto size = sf::Vector2f(mask.get_size());
+        return {
+            static_cast<int32_t>(std::lround(center.x - size.x / 2.f)),
+            static_cast<int32_t>(std::lround(center.y - size.y / 2.f))
+        };
+    }//!get_mask_origin
+
+    /** @returns Margins that shrink the sprite box to the solid area of its mask. */
+    Hitbox_margins get_mask_margins(const Collision_mask& mask)
+    {
+        const auto& area = mask.get_solid_area();
+        if (area.size.x <= 0 || area.size.y <= 0) return {};
+
+        const auto size = sf::Vector2f(mask.get_size());
+        return {
+            static_cast<float>(area.position.x) / size.x,
+            static_cast<float>(area.position.y) / size.y,
+            static_cast<float>(size.x - area.position.x - area.size.x) / size.x,
+            static_cast<float>(size.y - area.position.y - area.size.y) / size.y
+        };
+    }//!get_mask_margins
+
+    /** @returns true if the placed masks share a solid pixel (true if either mask is missing). */
+    bool masks_overlap(
+        const Collision_mask& a, const sf::Vector2f& a_center,
+        const Collision_mask& b, const sf::Vector2f& b_center
+    )
+    {
+        if (a.empty() || b.empty()) return true; // Bounding box hit stands
+        return Collision_mask::overlaps(a, get_mask_origin(a, a_center), b, get_mask_origin(b, b_center));
+    }//!masks_overlap
+
+    /** @returns One storage per archetype, all allocating from the given resource. */
+    template <size_t... I>
+    std::array<Enemy_storage, enemy_type_count> make_enemy_storages(std::pmr::memory_resource* resource, std::index_sequence<I...>)
+    {
+        return { { Enemy_storage(((void)I, resource))... } };
+    }//!make_enemy_storages
+
+    /** @brief Incremental 64-bit FNV-1a hash. */
+    class State_hasher
+    {
+    public:
+        /** @brief Mixes raw bytes of trivially copyable values into the hash. */
+        template <typename T>
+        void add(std::span<const T> values)
+        {
+            const auto bytes = std::as_bytes(values);
+            for (const auto byte : bytes)
+            {
+                hash_ ^= static_cast<uint64_t>(byte);
+                hash_ *= 1099511628211ull; // FNV prime
+            }
+        }//!add
+
+        /** @brief Mixes a single value into the hash. */
+        template <typename T>
+        void add(const T& value) { add(std::span<const T>(&value, 1u)); }
+
+        /** @returns Current hash value. */
+        FLEV_NODISCARD uint64_t get() const { return hash_; }
+
+    private:
+        uint64_t hash_ = 14695981039346656037ull; ///< FNV offset basis.
+    };
+}
+
+Game_world::Game_world(
+    const int32_t level_id,
+    const sf::Vector2u& world_size,
+    const uint64_t seed,
+    std::pmr::memory_resource* level_resource,
+    const size_t bullet_capacity
+)
+    : scratch_(scratch_capacity_, level_resource)
+    , level_id_(level_id)
+    , world_size_(world_size)
+    , seed_(seed)
+    , rng_(seed)
+    , level_timer_(sim_clock_)
+    , spawn_clock_(sim_clock_)
+    , player_(sim_clock_)
+    , enemies_(make_enemy_storages(level_resource, std::make_index_sequence<enemy_type_count>{}))
+    , bullets_(bullet_capacity, level_resource)
+    , enemy_bullets_(bullet_capacity, level_resource)
+    , last_spawns_(level_resource)
+    , enemy_grid_(16.f, level_resource)
+    , enemy_bullet_grid_(16.f, level_resource)
+    , enemy_ref_types_(level_resource)
+    , enemy_ref_indices_(level_resource)
+    , enemy_bounds_(level_resource)
+    , enemy_destroyed_(level_resource)
+    , enemy_bullet_hit_(level_resource)
+    , bullet_hit_(level_resource)
+{
+    switch (level_id_)
+    {
+    case 0:
+        level_duration_ = 120.f;
+        spawn_time_ = 1.5f;
+		break;
+
+    default:
+        level_duration_ = 0.f;
+        spawn_time_ = 3.f;
+		break;
+    }
+
+    for (size_t type_id = 0; type_id < enemy_type_count; ++type_id)
+    {
+        enemies_[type_id].hitbox = enemy_hitbox_margins[type_id];
+    }
+    player_.teleport(sf::Vector2f(world_size_.x / 6.f, world_size_.y / 2.f));
+}//!Game_world
+//---------------------------------------------------------------------------------------
+
+void Game_world::set_player_size(const sf::Vector2f& size)
+{
+    player_.set_size(size);
+}//!set_player_size
+//---------------------------------------------------------------------------------------
+
+void Game_world::set_enemy_size(const Enemy_type type, const sf::Vector2f& size)
+{
+    enemies_[to_index(type)].sprite_size = size;
+}//!set_enemy_size
+//---------------------------------------------------------------------------------------
+
+void Game_world::set_bullet_sizes(const sf::Vector2f& bullet_size, const sf::Vector2f& enemy_bullet_size)
+{
+    bullets_.set_sprite_size(bullet_size);
+    enemy_bullets_.set_sprite_size(enemy_bullet_size);
+}//!set_bullet_sizes
+//---------------------------------------------------------------------------------------
+
+void Game_world::set_job_system(Job_system* job_system)
+{
+    job_system_ = job_system;
+}//!set_job_system
+//---------------------------------------------------------------------------------------
+
+void Game_world::set_player_mask(const Collision_mask& mask)
+{
+    player_mask_ = mask;
+    if (!mask.empty()) player_.set_hitbox(get_mask_margins(mask));
+}//!set_player_mask
+//---------------------------------------------------------------------------------------
+
+void Game_world::set_enemy_mask(const Enemy_type type, const Collision_mask& mask)
+{
+    enemy_masks_[to_index(type)] = mask;
+    enemy_half_turn_masks_[to_index(type)] = mask.rotated_180();
+    if (!mask.empty()) enemies_[to_index(type)].hitbox = get_mask_margins(mask);
+}//!set_enemy_mask
+//---------------------------------------------------------------------------------------
+
+void Game_world::set_bullet_masks(const Collision_mask& bullet_mask, const Collision_mask& enemy_bullet_mask)
+{
+    bullet_mask_ = bullet_mask;
+    enemy_bullet_mask_ = enemy_bullet_mask;
+}//!set_bullet_masks
+//---------------------------------------------------------------------------------------
+
+void Game_world::spawn_swarm(const size_t enemy_count, const size_t bullet_count)
+{
+    // Clear of the player's start position, so the swarm does not end the run on the first tick
+    const auto random_spot = [this] {
+        const uint32_t min_x = world_size_.x / 3u;
+        return sf::Vector2f(
+            static_cast<float>(min_x + rng_.next_below(world_size_.x - min_x)),
+            static_cast<float>(rng_.next_below(world_size_.y))
+        );
+    };
+
+    for_each_enemy_archetype([&]<typename T>(std::type_identity<T>) {
+        const auto type_id = to_index(T::type);
+        const size_t count = enemy_count / enemy_type_count + (type_id < enemy_count % enemy_type_count ? 1u : 0u);
+        for (size_t i = 0; i < count; ++i) enemies_[type_id].template spawn<T>(random_spot());
+    });
+
+    for (size_t i = 0; i < bullet_count; ++i)
+    {
+        if (i % 2u == 0u) bullets_.spawn(random_spot(), Bullet::velocity);
+        else enemy_bullets_.spawn(random_spot(), Enemy_bullet::velocity);
+    }
+}//!spawn_swarm
+//---------------------------------------------------------------------------------------
+
+World_status Game_world::update(const float dt, const Player_input& input)
+{
+    // Previous state for render interpolation (also freezes interpolation while paused)
+    save_previous_state();
+
+    if (sim_clock_.advance(dt) <= 0.f) return World_status::Running; // Paused
+    ++stats_.ticks;
+    scratch_.reset(); // Nothing from the previous tick is still referenced
+
+    if (!player_.is_alive()) return World_status::Defeat;
+
+    FLEV_PROFILE_ZONE("Game_world::update");
+    auto phase_start = Stats_clock::now();
+    {
+        FLEV_PROFILE_ZONE("spawn");
+        update_spawn();
+    }
+    stats_.spawn_time += lap(phase_start);
+
+    if (const auto status = check_victory(); status != World_status::Running) return status;
+
+    {
+        FLEV_PROFILE_ZONE("movement");
+        update_movement(dt, input);
+    }
+    stats_.movement_time += lap(phase_start);
+
+    {
+        FLEV_PROFILE_ZONE("collisions");
+        update_collisions();
+    }
+    stats_.collision_time += lap(phase_start);
+
+    return World_status::Running;
+}//!update
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD int32_t Game_world::get_level_id() const
+{
+    return level_id_;
+}//!get_level_id
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD uint64_t Game_world::get_seed() const
+{
+    return seed_;
+}//!get_seed
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD const sf::Vector2u& Game_world::get_world_size() const
+{
+    return world_size_;
+}//!get_world_size
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD Sim_clock& Game_world::get_sim_clock()
+{
+    return sim_clock_;
+}//!get_sim_clock
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD const Sim_clock& Game_world::get_sim_clock() const
+{
+    return sim_clock_;
+}//!get_sim_clock
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD const Player& Game_world::get_player() const
+{
+    return player_;
+}//!get_player
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD const Enemy_storage& Game_world::get_enemies(const Enemy_type type) const
+{
+    return enemies_[to_index(type)];
+}//!get_enemies
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD const Bullet_pool& Game_world::get_bullets() const
+{
+    return bullets_;
+}//!get_bullets
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD const Bullet_pool& Game_world::get_enemy_bullets() const
+{
+    return enemy_bullets_;
+}//!get_enemy_bullets
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD const Spatial_hash& Game_world::get_enemy_grid() const
+{
+    return enemy_grid_;
+}//!get_enemy_grid
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD const Spatial_hash& Game_world::get_enemy_bullet_grid() const
+{
+    return enemy_bullet_grid_;
+}//!get_enemy_bullet_grid
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD std::span<const sf::Vector2f> Game_world::get_last_spawns() const
+{
+    return last_spawns_;
+}//!get_last_spawns
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD int32_t Game_world::get_score() const
+{
+    return score_;
+}//!get_score
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD float Game_world::get_level_duration() const
+{
+    return level_duration_;
+}//!get_level_duration
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD float Game_world::get_remaining_time() const
+{
+    return level_duration_ - level_timer_.get_elapsed();
+}//!get_remaining_time
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD int32_t Game_world::get_remaining_enemies() const
+{
+    return total_scout_enemies_ + total_warrior_enemies_;
+}//!get_remaining_enemies
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD const World_stats& Game_world::get_stats() const
+{
+    return stats_;
+}//!get_stats
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD uint64_t Game_world::compute_state_hash() const
+{
+    State_hasher hasher;
+    hasher.add(sim_clock_.get_tick());
+    hasher.add(rng_.get_state());
+    hasher.add(wave_number_);
+    hasher.add(score_);
+    hasher.add(total_scout_enemies_);
+    hasher.add(total_warrior_enemies_);
+
+    hasher.add(player_.get_position());
+    hasher.add(player_.get_hp());
+
+    for (const auto& enemies : enemies_)
+    {
+        hasher.add(enemies.size());
+        hasher.add(std::span<const sf::Vector2f>(enemies.positions));
+        hasher.add(std::span<const sf::Vector2f>(enemies.velocities));
+        hasher.add(std::span<const uint32_t>(enemies.hp));
+        hasher.add(std::span<const uint8_t>(enemies.phases));
+        hasher.add(std::span<const float>(enemies.timers));
+    }
+    for (const auto* bullets : { &bullets_, &enemy_bullets_ })
+    {
+        hasher.add(bullets->size());
+        hasher.add(bullets->positions());
+    }
+    return hasher.get();
+}//!compute_state_hash
+//---------------------------------------------------------------------------------------
+
+void Game_world::save_previous_state()
+{
+    player_.save_previous_position();
+    bullets_.save_previous_positions();
+    enemy_bullets_.save_previous_positions();
+    for (auto& enemies : enemies_) enemies.save_previous_positions();
+}//!save_previous_state
+//---------------------------------------------------------------------------------------
+
+void Game_world::update_spawn()
+{
+    // Enemies spawn
+    if (spawn_clock_.get_elapsed() > spawn_time_)
+    {
+        spawn_enemy();
+        spawn_clock_.restart();
+    }
+
+	// Bullets spawn
+    if (player_.is_need_to_shoot())
+    {
+        const auto pb = player_.get_bounds();
+        bullets_.spawn(
+            sf::Vector2f(pb.position.x + pb.size.x, pb.position.y + pb.size.y / 2.f),
+            Bullet::velocity
+        );
+    }
+}//!update_spawn
+//---------------------------------------------------------------------------------------
+
+void Game_world::update_movement(const float dt, const Player_input& input)
+{
+	// Player update
+    player_.update(dt, world_size_, input);
+
+	// Bullets update (chunks move disjoint rows, despawns stay serial and in order)
+    for_each_chunk(bullets_.size(), bullet_chunk_rows_, [&](const size_t begin, const size_t end, size_t) {
+        bullets_.update(dt, begin, end);
+    });
+    for (size_t i = bullets_.size(); i-- > 0; )
+    {
+        if (bullets_.is_out_of_bounds(i, world_size_)) bullets_.swap_remove(i);
+    }
+
+    // Enemy bullets update
+    for_each_chunk(enemy_bullets_.size(), bullet_chunk_rows_, [&](const size_t begin, const size_t end, size_t) {
+        enemy_bullets_.update(dt, begin, end);
+    });
+    for (size_t i = enemy_bullets_.size(); i-- > 0; )
+    {
+        if (enemy_bullets_.is_out_of_bounds(i, world_size_)) enemy_bullets_.swap_remove(i);
+    }
+
+	// Enemies update (one homogeneous, statically dispatched pass per archetype)
+    std::pmr::vector<size_t> shooters(scratch_.get_resource());
+    for_each_enemy_archetype([&]<typename T>(std::type_identity<T>) { update_archetype<T>(dt, shooters); });
+
+    // Enemy shooting (only warriors fire)
+    const auto& warriors = enemies_[to_index(Enemy_type::Warrior)];
+    for (const auto i : shooters)
+    {
+        const auto& enemy_bounds = warriors.bounds[i];
+        enemy_bullets_.spawn(
+            sf::Vector2f(enemy_bounds.position.x, enemy_bounds.position.y + enemy_bounds.size.y / 2.f),
+            Enemy_bullet::velocity
+        );
+    }
+
+    for (size_t type_id = 0; type_id < enemy_type_count; ++type_id)
+    {
+        auto& enemies = enemies_[type_id];
+        stats_.peak_enemies[type_id] = std::max(stats_.peak_enemies[type_id], enemies.size());
+        for (size_t i = enemies.size(); i-- > 0; )
+        {
+            if (enemies.is_out_of_bounds(i)) enemies.swap_remove(i);
+        }
+    }
+}//!update_movement
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD size_t Game_world::get_chunk_count(const size_t count, const size_t min_chunk_rows) const
+{
+    if (job_system_) return job_system_->get_chunk_count(count, min_chunk_rows);
+    return count > 0u ? 1u : 0u;
+}//!get_chunk_count
+//---------------------------------------------------------------------------------------
+
+template <typename F>
+void Game_world::for_each_chunk(const size_t count, const size_t min_chunk_rows, F&& fn)
+{
+    if (job_system_) job_system_->parallel_for(count, min_chunk_rows, fn);
+    else if (count > 0u) fn(size_t{ 0 }, count, size_t{ 0 });
+}//!for_each_chunk
+//---------------------------------------------------------------------------------------
+
+template <typename T>
+void Game_world::update_archetype(const float dt, std::pmr::vector<size_t>& shooters)
+{
+    auto& enemies = enemies_[to_index(T::type)];
+    const size_t chunk_count = get_chunk_count(enemies.size(), enemy_chunk_rows_);
+    if (chunk_count == 0u) return;
+
+    // The scratch arena is not thread-safe: reserve every chunk's worst case here so chunks never allocate
+    const size_t max_chunk_rows = (enemies.size() + chunk_count - 1u) / chunk_count;
+    std::pmr::vector<std::pmr::vector<size_t>> chunk_shooters(scratch_.get_resource());
+    chunk_shooters.resize(chunk_count);
+    for (auto& chunk : chunk_shooters) chunk.reserve(max_chunk_rows);
+
+    for_each_chunk(enemies.size(), enemy_chunk_rows_, [&](const size_t begin, const size_t end, const size_t chunk) {
+        const Enemy_update_context context{ dt, world_size_, chunk_shooters[chunk], begin, end };
+        T::update(enemies, context);
+    });
+
+    // Chunks cover ascending row ranges, so this is the serial order
+    for (const auto& chunk : chunk_shooters)
+    {
+        shooters.insert(shooters.end(), chunk.begin(), chunk.end());
+    }
+}//!update_archetype
+//---------------------------------------------------------------------------------------
+
+void Game_world::update_collisions()
+{
+    // Broadphase (entities do not move until the next tick)
+    auto broadphase_start = Stats_clock::now();
+    rebuild_broadphase();
+    stats_.broadphase_time += lap(broadphase_start);
+    const auto player_bounds = player_.get_bounds();
+    const auto player_position = player_.get_position();
+    std::pmr::vector<Spatial_hash::Id> candidates(scratch_.get_resource());
+    std::pmr::vector<uint8_t> player_hits(std::max(enemy_bounds_.size(), enemy_bullets_.size()), scratch_.get_resource());
+
+	// Enemy-player collisions (one box against all enemies, no broadphase needed)
+    const std::span enemy_hits(player_hits.data(), enemy_bounds_.size());
+    flev::simd::overlap_mask(player_bounds, enemy_bounds_, enemy_hits);
+    for (size_t id = 0; id < enemy_bounds_.size(); ++id)
+    {
+        if (!enemy_hits[id]) continue;
+        if (!enemy_mask_overlaps(id, player_mask_, player_position)) continue;
+
+        const auto is_player_dead = damage_player();
+        count_destroyed(enemy_ref_types_[id]);
+
+        // Do not erase enemy if player is dead (for game over screen)
+        if (!is_player_dead) enemy_destroyed_[id] = true;
+    }
+
+	// Bullet-bullet collisions (player vs enemy)
+    for (size_t bullet_id = 0; bullet_id < bullets_.size(); ++bullet_id)
+    {
+        enemy_bullet_grid_.query(bullets_.bounds()[bullet_id], candidates);
+        for (const auto id : candidates)
+        {
+            if (enemy_bullet_hit_[id]) continue;
+            if (bullets_.bounds()[bullet_id].findIntersection(enemy_bullets_.bounds()[id]) &&
+                masks_overlap(bullet_mask_, bullets_.positions()[bullet_id], enemy_bullet_mask_, enemy_bullets_.positions()[id]))
+            {
+                enemy_bullet_hit_[id] = true;
+                bullet_hit_[bullet_id] = true;
+                break;
+            }
+        }
+	}
+
+	// Bullet-enemy collisions
+    for (size_t bullet_id = 0; bullet_id < bullets_.size(); ++bullet_id)
+    {
+        if (bullet_hit_[bullet_id]) continue;
+
+        enemy_grid_.query(bullets_.bounds()[bullet_id], candidates);
+        for (const auto id : candidates)
+        {
+            if (enemy_destroyed_[id]) continue;
+            if (!bullets_.bounds()[bullet_id].findIntersection(enemy_bounds_[id])) continue;
+            if (!enemy_mask_overlaps(id, bullet_mask_, bullets_.positions()[bullet_id])) continue;
+
+            auto& enemies = enemies_[to_index(enemy_ref_types_[id])];
+            const auto index = enemy_ref_indices_[id];
+            if (enemies.take_damage(index, 1))  // Enemy destroyed
+            {
+                score_ += enemies.score_values[index];
+                enemy_destroyed_[id] = true;
+                count_destroyed(enemy_ref_types_[id]);
+            }
+            bullet_hit_[bullet_id] = true;
+            break;
+        }
+    }
+
+	// Bullet-player collisions (enemy bullets)
+    const std::span bullet_hits(player_hits.data(), enemy_bullets_.size());
+    flev::simd::overlap_mask(player_bounds, enemy_bullets_.bounds(), bullet_hits);
+    for (size_t id = 0; id < enemy_bullets_.size(); ++id)
+    {
+        if (!bullet_hits[id] || enemy_bullet_hit_[id]) continue;
+        if (!masks_overlap(player_mask_, player_position, enemy_bullet_mask_, enemy_bullets_.positions()[id])) continue;
+
+        if (damage_player())
+        {
+            // Do not continue checking if player is dead
+            break;
+        }
+        enemy_bullet_hit_[id] = true;
+	}
+
+    remove_destroyed();
+}//!update_collisions
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD World_status Game_world::check_victory()
+{
+    // Timed level
+    if (level_duration_ > 0)
+    {
+        if (static_cast<int32_t>(get_remaining_time()) <= 0)
+        {
+            score_ += player_.get_hp() * 10; // Bonus for remaining health
+            return World_status::Victory;
+        }
+    }
+    // Level 1 win condition
+    if (level_id_ == 1 && get_remaining_enemies() <= 0)
+    {
+		score_ += (200 - level_timer_.get_elapsed()) * 3; // Bonus for speed
+        score_ += player_.get_hp() * 10; // Bonus for remaining health
+        return World_status::Victory;
+    }
+    return World_status::Running;
+}//!check_victory
+//---------------------------------------------------------------------------------------
+
+void Game_world::spawn_enemy()
+{
+	// If level has a duration, do not spawn enemies in the last 5 seconds
+    if (level_duration_ > 0 &&
+        level_timer_.get_elapsed() > level_duration_ - 5)
+    {
+		return;
+    }
+    last_spawns_.clear();
+    switch (level_id_)
+    {
+    case 0: // Meteors
+    {
+        const float x = static_cast<float>(rng_.next_below(world_size_.x) + world_size_.x / 6);
+        if (wave_number_++ % 3)
+        {
+            last_spawns_.emplace_back(x + 150, -100);
+            enemies_[to_index(Enemy_type::Big_stone)].spawn<Big_stone>(last_spawns_.back());
+        }
+        last_spawns_.emplace_back(x + 50, -100);
+        enemies_[to_index(Enemy_type::Small_stone)].spawn<Small_stone>(last_spawns_.back());
+        break;
+    }
+    case 1: // Ships
+    {
+        if (wave_number_++ % 3 == 0)
+        {
+			// Spawn scouts (2 per every third wave)
+            for (size_t i = 0; i < 2; i++)
+            {
+                if (enemies_[to_index(Enemy_type::Scout)].size() >= total_scout_enemies_)
+                {
+                    break;
+                }
+                const float y = static_cast<float>(rng_.next_below(world_size_.y - 100u) + 50.f);
+                last_spawns_.emplace_back(world_size_.x + 50, y);
+                enemies_[to_index(Enemy_type::Scout)].spawn<Scout>(last_spawns_.back());
+            }
+        }
+        else
+        {
+            if (enemies_[to_index(Enemy_type::Warrior)].size() >= total_warrior_enemies_)
+            {
+                break;
+            }
+            const float y = static_cast<float>(rng_.next_below(world_size_.y / 2u));
+            last_spawns_.emplace_back(world_size_.x + 50, y);
+            enemies_[to_index(Enemy_type::Warrior)].spawn<Warrior>(last_spawns_.back());
+        }
+        break;
+    }
+    }
+}//!spawn_enemy
+//---------------------------------------------------------------------------------------
+
+void Game_world::rebuild_broadphase()
+{
+    // Enemy ids run through the archetypes in Enemy_type order. Columns are sized here, then
+    // chunks copy disjoint id ranges
+    std::array<size_t, enemy_type_count + 1u> first_ids{};
+    for (size_t type_id = 0; type_id < enemy_type_count; ++type_id)
+    {
+        first_ids[type_id + 1u] = first_ids[type_id] + enemies_[type_id].size();
+    }
+    const size_t enemy_count = first_ids.back();
+    enemy_ref_types_.resize(enemy_count);
+    enemy_ref_indices_.resize(enemy_count);
+    enemy_bounds_.resize(enemy_count);
+    for_each_chunk(enemy_count, bullet_chunk_rows_, [&](const size_t begin, const size_t end, size_t) {
+        size_t type_id = 0;
+        for (size_t id = begin; id < end; ++id)
+        {
+            while (id >= first_ids[type_id + 1u]) ++type_id;
+            const auto row = id - first_ids[type_id];
+            enemy_ref_types_[id] = static_cast<Enemy_type>(type_id);
+            enemy_ref_indices_[id] = static_cast<uint32_t>(row);
+            enemy_bounds_[id] = enemies_[type_id].bounds[row];
+        }
+    });
+    enemy_grid_.rebuild(enemy_bounds_, job_system_, bullet_chunk_rows_);
+    enemy_destroyed_.assign(enemy_bounds_.size(), false);
+
+    enemy_bullet_grid_.rebuild(enemy_bullets_.bounds(), job_system_, bullet_chunk_rows_);
+    enemy_bullet_hit_.assign(enemy_bullets_.size(), false);
+
+    // Player bullets only query the grids
+    bullet_hit_.assign(bullets_.size(), false);
+}//!rebuild_broadphase
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD bool Game_world::enemy_mask_overlaps(const size_t id, const Collision_mask& mask, const sf::Vector2f& center) const
+{
+    const auto type_id = to_index(enemy_ref_types_[id]);
+    const auto& enemies = enemies_[type_id];
+    const auto index = enemy_ref_indices_[id];
+
+    // Masks are axis-aligned: upright and half-turned enemies (scouts after their U-turn) test
+    // pixels, enemies caught mid-turn keep their bounding box result
+    const float rotation = enemies.rotations[index];
+    if (rotation == 0.f) return masks_overlap(enemy_masks_[type_id], enemies.positions[index], mask, center);
+    if (is_half_turn(rotation)) return masks_overlap(enemy_half_turn_masks_[type_id], enemies.positions[index], mask, center);
+    return true;
+}//!enemy_mask_overlaps
+//---------------------------------------------------------------------------------------
+
+bool Game_world::damage_player()
+{
+    return player_.take_damage(1);
+}//!damage_player
+//---------------------------------------------------------------------------------------
+
+void Game_world::count_destroyed(const Enemy_type type)
+{
+    if (type == Enemy_type::Scout) total_scout_enemies_--;
+    else if (type == Enemy_type::Warrior) total_warrior_enemies_--;
+}//!count_destroyed
+//---------------------------------------------------------------------------------------
+
+void Game_world::remove_destroyed()
+{
+    // Walk backwards so swap-removal never moves an unvisited row
+    for (size_t i = bullets_.size(); i-- > 0; )
+    {
+        if (bullet_hit_[i]) bullets_.swap_remove(i);
+    }
+    for (size_t i = enemy_bullets_.size(); i-- > 0; )
+    {
+        if (enemy_bullet_hit_[i]) enemy_bullets_.swap_remove(i);
+    }
+    for (size_t id = enemy_destroyed_.size(); id-- > 0; )
+    {
+        if (enemy_destroyed_[id])
+        {
+            enemies_[to_index(enemy_ref_types_[id])].swap_remove(enemy_ref_indices_[id]);
+        }
+    }
+}//!remove_destroyed
+//---------------------------------------------------------------------------------------
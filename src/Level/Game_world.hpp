@@ -0,0 +1,323 @@
+#pragma once
+#include <utils/defines.hpp>
+#include <utils/spatial_hash.hpp>
+#include <utils/sim_clock.hpp>
+#include <utils/rng.hpp>
+#include <utils/collision_mask.hpp>
+#include <utils/job_system.hpp>
+#include <utils/arena.hpp>
+#include <Entities/Enemy.hpp>
+#include <Entities/Player.hpp>
+#include <Entities/Bullet.hpp>
+#include <SFML/Graphics.hpp>
+#include <memory_resource>
+#include <vector>
+#include <array>
+#include <span>
+
+/** @brief Outcome of a simulation tick. */
+enum class World_status : uint8_t
+{
+    Running,
+    Victory,
+    Defeat
+};
+
+/** @brief Accumulated cost of Game_world::update phases (wall-clock seconds). */
+struct World_stats
+{
+    uint64_t ticks = 0u;                                 ///< Executed (not paused) ticks.
+    double spawn_time = 0.0;                             ///< Spawning enemies and shots.
+    double movement_time = 0.0;                          ///< Moving entities and culling off-screen ones.
+    double collision_time = 0.0;                         ///< Broadphase rebuild and collision passes.
+    double broadphase_time = 0.0;                        ///< Broadphase rebuild alone (part of collision_time).
+    std::array<size_t, enemy_type_count> peak_enemies{}; ///< Peak live enemies per archetype.
+};
+
+/**
+ * @brief Gameplay simulation of one level.
+ *
+ * Owns the player, enemies, bullets and all gameplay timers, and advances
+ * them by fixed ticks. Does not touch windows, textures or the keyboard:
+ * entity sizes and player input are provided by the caller, so the same
+ * simulation runs inside Game_scene and in the headless benchmark.
+ *
+ * Containers that live as long as the level allocate from the resource
+ * given to the constructor; buffers needed for one tick only come from a
+ * scratch arena that every update() rewinds.
+ */
+class Game_world
+{
+public:
+
+    static constexpr size_t default_bullet_capacity = 256u; ///< Max live bullets per pool in regular play.
+
+    /**
+     * @brief Constructs the world for the given level.
+     *
+     * @param level_id[in]   - Level rules to use (spawns, duration, win condition).
+     * @param world_size[in] - Playfield size in pixels.
+     * @param seed[in][opt]  - Seed of all gameplay randomness (same seed and input give the same run). [Default: 0]
+     * @param level_resource[in][opt] - Memory of entity columns, broadphase and the tick scratch buffer
+     *                                  (usually a Level_arena that outlives the world). [Default: heap]
+     * @param bullet_capacity[in][opt] - Max live bullets of each bullet pool (shots past it are dropped).
+     *                                   [Default: default_bullet_capacity]
+     */
+    Game_world(
+        const int32_t level_id,
+        const sf::Vector2u& world_size,
+        const uint64_t seed = 0u,
+        std::pmr::memory_resource* level_resource = std::pmr::get_default_resource(),
+        const size_t bullet_capacity = default_bullet_capacity
+    );
+
+    /** @brief Sets scaled sprite size of the player (collision bounds). */
+    void set_player_size(const sf::Vector2f& size);
+
+    /** @brief Sets scaled sprite size of the given enemy archetype (collision bounds). */
+    void set_enemy_size(const Enemy_type type, const sf::Vector2f& size);
+
+    /** @brief Sets scaled sprite sizes of player and enemy bullets (collision bounds). */
+    void set_bullet_sizes(const sf::Vector2f& bullet_size, const sf::Vector2f& enemy_bullet_size);
+
+    /**
+     * @brief Sets the player's pixel mask and fits the collision box to its solid area.
+     *
+     * Masks are optional: without one, collisions stop at the bounding box test.
+     *
+     * @param mask[in] - Mask already scaled to the sprite scale.
+     */
+    void set_player_mask(const Collision_mask& mask);
+
+    /** @brief Sets pixel mask of the given enemy archetype and fits its collision box (see set_player_mask). */
+    void set_enemy_mask(const Enemy_type type, const Collision_mask& mask);
+
+    /** @brief Sets pixel masks of player and enemy bullets (already scaled to sprite scale). */
+    void set_bullet_masks(const Collision_mask& bullet_mask, const Collision_mask& enemy_bullet_mask);
+
+    /**
+     * @brief Runs bullet and enemy movement on the given job system.
+     *
+     * Results do not depend on the thread count: chunks write disjoint rows,
+     * and shots and despawns are merged in row order afterwards.
+     *
+     * @param job_system[in] - Shared job system (nullptr updates on the calling thread). Must outlive the world.
+     */
+    void set_job_system(Job_system* job_system);
+
+    /**
+     * @brief Adds enemies and bullets at random spots of the right two thirds of the playfield.
+     *
+     * Used by stress benchmarks to load the world far beyond regular waves.
+     * Enemies are split evenly between archetypes and bullets between the
+     * player and enemy pools (shots past the pool capacity are dropped).
+     * Spots come from the world's RNG, so the same seed gives the same swarm.
+     *
+     * @param enemy_count[in]  - Enemies to add.
+     * @param bullet_count[in] - Bullets to add.
+     */
+    void spawn_swarm(const size_t enemy_count, const size_t bullet_count);
+
+    /**
+     * @brief Advances the simulation by one tick.
+     *
+     * Does nothing while the simulation clock is paused.
+     *
+     * @param dt[in]    - Tick duration in seconds.
+     * @param input[in] - Player controls for this tick.
+     *
+     * @returns Victory/Defeat once the level ends (final score included), Running otherwise.
+     */
+    World_status update(const float dt, const Player_input& input);
+
+    /** @returns Level ID. */
+    FLEV_NODISCARD int32_t get_level_id() const;
+
+    /** @returns Seed the world was created with. */
+    FLEV_NODISCARD uint64_t get_seed() const;
+
+    /** @returns Playfield size in pixels. */
+    FLEV_NODISCARD const sf::Vector2u& get_world_size() const;
+
+    /** @returns Simulation clock (pause and time scale are controlled through it). */
+    FLEV_NODISCARD Sim_clock& get_sim_clock();
+    FLEV_NODISCARD const Sim_clock& get_sim_clock() const;
+
+    /** @returns Player ship. */
+    FLEV_NODISCARD const Player& get_player() const;
+
+    /** @returns Enemies of the given archetype. */
+    FLEV_NODISCARD const Enemy_storage& get_enemies(const Enemy_type type) const;
+
+    /** @returns Player-fired bullets. */
+    FLEV_NODISCARD const Bullet_pool& get_bullets() const;
+
+    /** @returns Enemy-fired bullets. */
+    FLEV_NODISCARD const Bullet_pool& get_enemy_bullets() const;
+
+    /** @returns Broadphase over all enemies (as of the last collision pass). */
+    FLEV_NODISCARD const Spatial_hash& get_enemy_grid() const;
+
+    /** @returns Broadphase over enemy bullets (as of the last collision pass). */
+    FLEV_NODISCARD const Spatial_hash& get_enemy_bullet_grid() const;
+
+    /** @returns Spawn positions of the latest enemy wave. */
+    FLEV_NODISCARD std::span<const sf::Vector2f> get_last_spawns() const;
+
+    /** @returns Current score. */
+    FLEV_NODISCARD int32_t get_score() const;
+
+    /** @returns Time limit for timed levels (0 if the level is not timed). */
+    FLEV_NODISCARD float get_level_duration() const;
+
+    /** @returns Seconds left until the end of a timed level. */
+    FLEV_NODISCARD float get_remaining_time() const;
+
+    /** @returns Enemies left to destroy (level 1). */
+    FLEV_NODISCARD int32_t get_remaining_enemies() const;
+
+    /** @returns Accumulated phase timings and peak counts. */
+    FLEV_NODISCARD const World_stats& get_stats() const;
+
+    /**
+     * @brief Hashes the gameplay state (FNV-1a over entities, score, timers and RNG).
+     *
+     * Equal hashes on the same tick mean the runs have not diverged. Render-only
+     * state (previous positions, rotations) and stats are not included.
+     */
+    FLEV_NODISCARD uint64_t compute_state_hash() const;
+
+private/*methods*/:
+
+    /** @brief Copies current positions into previous-state buffers before a tick. */
+    void save_previous_state();
+
+    /** @brief Spawns enemies on timer and the player's shot. */
+    void update_spawn();
+
+    /** @brief Moves all entities and removes the ones that left the screen. */
+    void update_movement(const float dt, const Player_input& input);
+
+    /** @returns Number of chunks for_each_chunk() splits count rows into. */
+    FLEV_NODISCARD size_t get_chunk_count(const size_t count, const size_t min_chunk_rows) const;
+
+    /**
+     * @brief Runs fn(begin, end, chunk) over count rows on the job system (in one chunk without it).
+     *
+     * @param count[in]          - Rows to process.
+     * @param min_chunk_rows[in] - Smallest row range worth running on another thread (see Threading constants).
+     * @param fn[in]             - Chunk callback; chunks write disjoint rows or per-chunk buffers.
+     */
+    template <typename F>
+    void for_each_chunk(const size_t count, const size_t min_chunk_rows, F&& fn);
+
+    /**
+     * @brief Updates all enemies of archetype T in parallel chunks.
+     *
+     * @param dt[in]        - Tick duration in seconds.
+     * @param shooters[out] - Receives rows of enemies that fire this tick (in row order).
+     */
+    template <typename T>
+    void update_archetype(const float dt, std::pmr::vector<size_t>& shooters);
+
+    /** @brief Runs collision passes and removes destroyed entities. */
+    void update_collisions();
+
+    /** @brief Checks level win conditions and adds end-of-level bonuses. */
+    FLEV_NODISCARD World_status check_victory();
+
+    /** @brief Spawns enemies according to current level rules. */
+    void spawn_enemy();
+
+    /** @brief Caches bounds of all collidable entities and rebuilds broadphase grids (in chunks on the job system). */
+    void rebuild_broadphase();
+
+    /**
+     * @brief Narrowphase between an enemy and a placed mask, run after their boxes overlap.
+     *
+     * @param id[in]     - Enemy id in the broadphase arrays.
+     * @param mask[in]   - Mask of the other entity.
+     * @param center[in] - Sprite center of the other entity.
+     *
+     * @returns true if they share a solid pixel (also true while the enemy is mid-turn or either mask is missing).
+     */
+    FLEV_NODISCARD bool enemy_mask_overlaps(const size_t id, const Collision_mask& mask, const sf::Vector2f& center) const;
+
+    /** @brief Applies one point of damage to player. Returns true if player died. */
+    bool damage_player();
+
+    /** @brief Decrements remaining enemy counters for win condition (level 1). */
+    void count_destroyed(const Enemy_type type);
+
+    /** @brief Erases enemies and bullets flagged by collision passes. */
+    void remove_destroyed();
+
+private/*vars*/:
+
+    // -----------------------------------------------------------------------
+    // Memory
+    // -----------------------------------------------------------------------
+    static constexpr size_t scratch_capacity_ = 64u * 1024u; ///< Tick scratch buffer size (bytes).
+    Scratch_arena scratch_;                                  ///< Per-tick buffers (shooters, query results, hit masks), reset by update().
+
+    // -----------------------------------------------------------------------
+    // Level state
+    // -----------------------------------------------------------------------
+    const int32_t level_id_;         ///< Current level ID.
+    const sf::Vector2u world_size_;  ///< Playfield size in pixels.
+    const uint64_t seed_;            ///< Seed of rng_.
+    Rng rng_;                        ///< Source of all gameplay randomness.
+    uint8_t wave_number_ = 0u;       ///< Spawned waves (selects wave composition).
+    float level_duration_ = 120.f;   ///< Time limit for timed levels (seconds).
+    float spawn_time_ = 5.f;         ///< Base enemy spawn interval (seconds).
+    Sim_clock sim_clock_;            ///< Simulation time for all gameplay timers.
+    Sim_timer level_timer_;          ///< Elapsed time since level start.
+    Sim_timer spawn_clock_;          ///< Timer for next enemy spawn.
+
+    // -----------------------------------------------------------------------
+    // Game entities
+    // -----------------------------------------------------------------------
+    Player player_;                                        ///< Player ship.
+    std::array<Enemy_storage, enemy_type_count> enemies_;  ///< Enemies by archetype (see Enemy_type).
+    Bullet_pool bullets_;                                  ///< Player-fired bullets.
+    Bullet_pool enemy_bullets_;                            ///< Enemy-fired bullets.
+    std::pmr::vector<sf::Vector2f> last_spawns_;           ///< Spawn positions of the latest wave (debug drawing).
+
+    // -----------------------------------------------------------------------
+    // Collision broadphase (rebuilt every tick)
+    // -----------------------------------------------------------------------
+    Spatial_hash enemy_grid_;                        ///< Broadphase over all enemies.
+    Spatial_hash enemy_bullet_grid_;                 ///< Broadphase over enemy bullets.
+    std::pmr::vector<Enemy_type> enemy_ref_types_;   ///< Enemy id -> archetype.
+    std::pmr::vector<uint32_t> enemy_ref_indices_;   ///< Enemy id -> row in archetype storage.
+    std::pmr::vector<sf::FloatRect> enemy_bounds_;   ///< Enemy id -> bounds.
+    std::pmr::vector<uint8_t> enemy_destroyed_;      ///< Enemy id -> marked for removal.
+    std::pmr::vector<uint8_t> enemy_bullet_hit_;     ///< Enemy bullet id -> marked for removal.
+    std::pmr::vector<uint8_t> bullet_hit_;           ///< Player bullet id -> marked for removal.
+
+    // -----------------------------------------------------------------------
+    // Collision narrowphase (pixel masks at sprite scale, empty if not set)
+    // -----------------------------------------------------------------------
+    Collision_mask player_mask_;                                 ///< Player ship.
+    std::array<Collision_mask, enemy_type_count> enemy_masks_;   ///< Enemies by archetype (see Enemy_type).
+    std::array<Collision_mask, enemy_type_count> enemy_half_turn_masks_; ///< enemy_masks_ rotated by 180 degrees.
+    Collision_mask bullet_mask_;                                 ///< Player bullet.
+    Collision_mask enemy_bullet_mask_;                           ///< Enemy bullet.
+
+    // -----------------------------------------------------------------------
+    // Game state
+    // -----------------------------------------------------------------------
+    int32_t score_ = 0;                   ///< Current score (accumulated during level).
+    uint16_t total_scout_enemies_ = 16u;  ///< Remaining scout enemies (level 1).
+    uint16_t total_warrior_enemies_ = 8u; ///< Remaining warrior enemies (level 1).
+    World_stats stats_;                   ///< Phase timings and peak counts.
+
+    // -----------------------------------------------------------------------
+    // Threading
+    // -----------------------------------------------------------------------
+    // Smallest row ranges worth running on another thread. Cheaper rows need longer chunks to pay
+    // for the hand-off; large counts are capped by Job_system's chunk limit anyway
+    static constexpr size_t enemy_chunk_rows_ = 32u;  ///< Enemy rows (per-archetype steering and shooting logic).
+    static constexpr size_t bullet_chunk_rows_ = 64u; ///< Bullet rows (one SIMD integration pass) and broadphase items (a few cell keys each).
+    Job_system* job_system_ = nullptr;                ///< Parallel update backend (not owned, optional).
+};
\ No newline at end of file
@@ -0,0 +1,210 @@
+#include "Replay.hpp"
+#include <utils/logger.hpp>
+#include <fstream>
+#include <iterator>
+
+namespace
+{
+    constexpr char replay_magic[4] = { 'F', 'L', 'R', 'P' }; ///< File signature.
+    constexpr uint32_t replay_version = 1u;                  ///< Bumped on layout changes.
+
+    /** @returns Player input packed into button bits. */
+    uint8_t pack_input(const Player_input& input)
+    {
+        return static_cast<uint8_t>(
+            (input.up ? 1u : 0u) |
+            (input.down ? 2u : 0u) |
+            (input.left ? 4u : 0u) |
+            (input.right ? 8u : 0u) |
+            (input.shoot ? 16u : 0u)
+        );
+    }//!pack_input
+
+    /** @returns Player input unpacked from button bits. */
+    Player_input unpack_input(const uint8_t mask)
+    {
+        return {
+            .up = (mask & 1u) != 0u,
+            .down = (mask & 2u) != 0u,
+            .left = (mask & 4u) != 0u,
+            .right = (mask & 8u) != 0u,
+            .shoot = (mask & 16u) != 0u
+        };
+    }//!unpack_input
+
+    /** @brief Appends an unsigned LEB128 varint. */
+    void write_varint(std::vector<uint8_t>& out, uint64_t value)
+    {
+        while (value >= 0x80u)
+        {
+            out.push_back(static_cast<uint8_t>(value | 0x80u));
+            value >>= 7u;
+        }
+        out.push_back(static_cast<uint8_t>(value));
+    }//!write_varint
+
+    /** @brief Sequential reader over a loaded file (reports truncation instead of reading past the end). */
+    class Byte_reader
+    {
+    public:
+        explicit Byte_reader(const std::vector<uint8_t>& data) : data_(data) {}
+
+        /** @brief Reads one byte. */
+        bool read_byte(uint8_t& out)
+        {
+            if (pos_ >= data_.size()) return false;
+            out = data_[pos_++];
+            return true;
+        }//!read_byte
+
+        /** @brief Reads an unsigned LEB128 varint. */
+        bool read_varint(uint64_t& out)
+        {
+            out = 0u;
+            for (uint32_t shift = 0u; shift < 64u; shift += 7u)
+            {
+                uint8_t byte = 0u;
+                if (!read_byte(byte)) return false;
+                out |= static_cast<uint64_t>(byte & 0x7Fu) << shift;
+                if ((byte & 0x80u) == 0u) return true;
+            }
+            return false;
+        }//!read_varint
+
+        /** @brief Reads a little-endian 32-bit word. */
+        bool read_u32(uint32_t& out)
+        {
+            out = 0u;
+            for (uint32_t shift = 0u; shift < 32u; shift += 8u)
+            {
+                uint8_t byte = 0u;
+                if (!read_byte(byte)) return false;
+                out |= static_cast<uint32_t>(byte) << shift;
+            }
+            return true;
+        }//!read_u32
+
+    private:
+        const std::vector<uint8_t>& data_; ///< File contents.
+        size_t pos_ = 0u;                  ///< Read position.
+    };
+}
+
+void Replay::record(const Player_input& input, const uint64_t state_hash)
+{
+    inputs.push_back(input);
+    state_hashes.push_back(fold_hash(state_hash));
+}//!record
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD bool Replay::save(const std::string& path) const
+{
+    std::vector<uint8_t> data(std::begin(replay_magic), std::end(replay_magic));
+    write_varint(data, replay_version);
+    write_varint(data, (static_cast<uint32_t>(level_id) << 1u) ^ static_cast<uint32_t>(level_id >> 31)); // Zigzag
+    write_varint(data, seed);
+    write_varint(data, tick_rate);
+    write_varint(data, world_size.x);
+    write_varint(data, world_size.y);
+    write_varint(data, inputs.size());
+
+    // Input runs
+    for (size_t i = 0; i < inputs.size(); )
+    {
+        const auto mask = pack_input(inputs[i]);
+        size_t run = 1u;
+        while (i + run < inputs.size() && pack_input(inputs[i + run]) == mask) ++run;
+        data.push_back(mask);
+        write_varint(data, run);
+        i += run;
+    }
+
+    // State hashes
+    for (const auto hash : state_hashes)
+    {
+        for (uint32_t shift = 0u; shift < 32u; shift += 8u) data.push_back(static_cast<uint8_t>(hash >> shift));
+    }
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open() || !file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size())))
+    {
+        LOG_ERROR(get_global_logger(), "Failed to write replay file: {}", path);
+        return false;
+    }
+    return true;
+}//!save
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD bool Replay::load(const std::string& path)
+{
+    *this = Replay{};
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open())
+    {
+        LOG_ERROR(get_global_logger(), "Failed to open replay file: {}", path);
+        return false;
+    }
+    const std::vector<uint8_t> data{ std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+
+    const auto fail = [this, &path](const char* reason) {
+        LOG_ERROR(get_global_logger(), "Invalid replay file {}: {}", path, reason);
+        *this = Replay{};
+        return false;
+    };
+
+    Byte_reader reader(data);
+    for (const auto expected : replay_magic)
+    {
+        uint8_t byte = 0u;
+        if (!reader.read_byte(byte) || byte != static_cast<uint8_t>(expected)) return fail("bad signature");
+    }
+
+    uint64_t version = 0u, zigzag_level = 0u, rate = 0u, width = 0u, height = 0u, tick_count = 0u;
+    if (!reader.read_varint(version)) return fail("truncated header");
+    if (version != replay_version) return fail("unsupported version");
+    if (!reader.read_varint(zigzag_level) || !reader.read_varint(seed) || !reader.read_varint(rate) ||
+        !reader.read_varint(width) || !reader.read_varint(height) || !reader.read_varint(tick_count))
+    {
+        return fail("truncated header");
+    }
+    level_id = static_cast<int32_t>(static_cast<uint32_t>(zigzag_level >> 1u) ^ (0u - static_cast<uint32_t>(zigzag_level & 1u)));
+    tick_rate = static_cast<uint32_t>(rate);
+    world_size = { static_cast<uint32_t>(width), static_cast<uint32_t>(height) };
+
+    // Every tick needs at least 4 hash bytes, reject bogus counts before allocating
+    if (tick_count > data.size() / 4u) return fail("tick count exceeds file size");
+
+    inputs.reserve(tick_count);
+    while (inputs.size() < tick_count)
+    {
+        uint8_t mask = 0u;
+        uint64_t run = 0u;
+        if (!reader.read_byte(mask) || !reader.read_varint(run)) return fail("truncated input");
+        if (run == 0u || run > tick_count - inputs.size()) return fail("bad input run");
+        inputs.insert(inputs.end(), run, unpack_input(mask));
+    }
+
+    state_hashes.resize(tick_count);
+    for (auto& hash : state_hashes)
+    {
+        if (!reader.read_u32(hash)) return fail("truncated state hashes");
+    }
+    return true;
+}//!load
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD uint32_t Replay::fold_hash(const uint64_t state_hash)
+{
+    return static_cast<uint32_t>(state_hash ^ (state_hash >> 32u));
+}//!fold_hash
+//---------------------------------------------------------------------------------------
+
+bool Replay_player::advance(const uint64_t state_hash)
+{
+    const auto matches = Replay::fold_hash(state_hash) == replay_->state_hashes[tick_];
+    if (!matches && divergence_tick_ < 0) divergence_tick_ = static_cast<int64_t>(tick_);
+    ++tick_;
+    return matches;
+}//!advance
+//---------------------------------------------------------------------------------------
@@ -0,0 +1,92 @@
+#pragma once
+#include <utils/defines.hpp>
+#include <Entities/Player.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+/** @brief Replay files requested on the command line. */
+struct Replay_options
+{
+    std::string record_path;   ///< Game runs are recorded here (nothing recorded if empty).
+    std::string playback_path; ///< Replay played back instead of keyboard input (none if empty).
+};
+
+/**
+ * @brief Recorded run of one level: seed, settings and per-tick input.
+ *
+ * Game_world is deterministic for a given seed, tick rate, world size and
+ * input sequence, so replaying the inputs reproduces the run. A per-tick
+ * state hash is stored to detect where a playback diverged.
+ *
+ * File layout (integers are LEB128 varints, signed ones zigzag encoded):
+ * magic "FLRP", version, level id, seed, tick rate, world width and height,
+ * tick count, input as (button mask byte, run length) pairs (held keys change
+ * rarely, so a run covers many ticks), then one little-endian 4-byte state
+ * hash per tick.
+ */
+struct Replay
+{
+    int32_t level_id = 0;               ///< Recorded level.
+    uint64_t seed = 0u;                 ///< Game_world seed.
+    uint32_t tick_rate = 60u;           ///< Simulation ticks per second.
+    sf::Vector2u world_size;            ///< Playfield size in pixels.
+    std::vector<Player_input> inputs;   ///< Input of every executed tick.
+    std::vector<uint32_t> state_hashes; ///< Folded Game_world::compute_state_hash() after every tick.
+
+    /** @brief Appends one executed tick. */
+    void record(const Player_input& input, const uint64_t state_hash);
+
+    /**
+     * @brief Writes the replay to a binary file.
+     *
+     * @returns false if the file could not be written.
+     */
+    FLEV_NODISCARD bool save(const std::string& path) const;
+
+    /**
+     * @brief Reads a replay written by save().
+     *
+     * @returns false if the file is missing, truncated or of another version (replay is left empty).
+     */
+    FLEV_NODISCARD bool load(const std::string& path);
+
+    /** @returns 32-bit hash stored per tick. */
+    FLEV_NODISCARD static uint32_t fold_hash(const uint64_t state_hash);
+};
+
+/** @brief Feeds a replay into a Game_world tick by tick and checks state hashes. */
+class Replay_player
+{
+public:
+
+    /** @brief Starts playback from the first tick (the replay must outlive the player). */
+    explicit Replay_player(const Replay& replay) : replay_(&replay) {}
+
+    /** @returns true while recorded ticks are left. */
+    FLEV_NODISCARD bool has_next() const { return tick_ < replay_->inputs.size(); }
+
+    /** @returns Input of the next tick (call only if has_next()). */
+    FLEV_NODISCARD const Player_input& get_input() const { return replay_->inputs[tick_]; }
+
+    /**
+     * @brief Moves to the next tick after comparing the world state with the recording.
+     *
+     * @param state_hash[in] - Game_world::compute_state_hash() after the tick.
+     *
+     * @returns false if the state differs from the recorded one.
+     */
+    bool advance(const uint64_t state_hash);
+
+    /** @returns Played ticks. */
+    FLEV_NODISCARD uint64_t get_tick() const { return tick_; }
+
+    /** @returns First tick whose state differed from the recording, -1 if none. */
+    FLEV_NODISCARD int64_t get_divergence_tick() const { return divergence_tick_; }
+
+private:
+    const Replay* replay_;         ///< Played replay.
+    uint64_t tick_ = 0u;           ///< Next tick to play.
+    int64_t divergence_tick_ = -1; ///< First diverged tick (-1 if none).
+};
@@ -0,0 +1,93 @@
+#include "Debug_draw.hpp"
+#include "Render_stats.hpp"
+
+Debug_draw::Debug_draw()
+    : lines_(sf::PrimitiveType::Lines)
+#ifdef NDEBUG
+    , enabled_(false)
+#else
+    , enabled_(true)
+#endif // NDEBUG
+{
+    channels_[static_cast<size_t>(Debug_channel::Collision_bounds)] = true;
+}//!Debug_draw
+//---------------------------------------------------------------------------------------
+
+void Debug_draw::toggle()
+{
+    enabled_ = !enabled_;
+}//!toggle
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD bool Debug_draw::is_enabled() const
+{
+    return enabled_;
+}//!is_enabled
+//---------------------------------------------------------------------------------------
+
+void Debug_draw::toggle_channel(const Debug_channel channel)
+{
+    auto& enabled = channels_[static_cast<size_t>(channel)];
+    enabled = !enabled;
+}//!toggle_channel
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD bool Debug_draw::is_channel_enabled(const Debug_channel channel) const
+{
+    return channels_[static_cast<size_t>(channel)];
+}//!is_channel_enabled
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD bool Debug_draw::is_active(const Debug_channel channel) const
+{
+    return enabled_ && is_channel_enabled(channel);
+}//!is_active
+//---------------------------------------------------------------------------------------
+
+void Debug_draw::add_line(const Debug_channel channel, const sf::Vector2f& from, const sf::Vector2f& to, const sf::Color color)
+{
+    if (!is_active(channel)) return;
+    lines_.append(sf::Vertex{ from, color });
+    lines_.append(sf::Vertex{ to, color });
+}//!add_line
+//---------------------------------------------------------------------------------------
+
+void Debug_draw::add_box(const Debug_channel channel, const sf::FloatRect& box, const sf::Color color)
+{
+    if (!is_active(channel)) return;
+    const sf::Vector2f corners[4] = {
+        box.position,
+        { box.position.x + box.size.x, box.position.y },
+        box.position + box.size,
+        { box.position.x, box.position.y + box.size.y }
+    };
+    for (size_t i = 0; i < 4; ++i)
+    {
+        lines_.append(sf::Vertex{ corners[i], color });
+        lines_.append(sf::Vertex{ corners[(i + 1) % 4], color });
+    }
+}//!add_box
+//---------------------------------------------------------------------------------------
+
+void Debug_draw::add_cross(const Debug_channel channel, const sf::Vector2f& center, const float half_size, const sf::Color color)
+{
+    add_line(channel, { center.x - half_size, center.y }, { center.x + half_size, center.y }, color);
+    add_line(channel, { center.x, center.y - half_size }, { center.x, center.y + half_size }, color);
+}//!add_cross
+//---------------------------------------------------------------------------------------
+
+void Debug_draw::flush(sf::RenderTarget& render_target)
+{
+    if (lines_.getVertexCount() == 0) return;
+    get_render_stats().vertices += lines_.getVertexCount();
+    draw_counted(render_target, lines_);
+    lines_.clear();
+}//!flush
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD Debug_draw& get_debug_draw()
+{
+    static Debug_draw debug_draw;
+    return debug_draw;
+}//!get_debug_draw
+//---------------------------------------------------------------------------------------
@@ -0,0 +1,69 @@
+#pragma once
+#include <utils/defines.hpp>
+#include <SFML/Graphics.hpp>
+#include <array>
+
+/** @brief Groups of debug geometry that can be toggled independently. */
+enum class Debug_channel : uint8_t
+{
+    Collision_bounds, ///< Collision boxes of all entities.
+    Broadphase_cells, ///< Occupied cells of the collision grids.
+    Spawn_points,     ///< Positions of the latest enemy wave.
+
+    Count
+};
+
+/** @brief Number of debug channels. */
+constexpr size_t debug_channel_count = static_cast<size_t>(Debug_channel::Count);
+
+/**
+ * @brief Runtime debug geometry collected into one vertex array per frame.
+ *
+ * Lines and boxes are appended during drawing and flushed with a single draw
+ * call. Geometry of disabled channels (or with the layer disabled) is dropped
+ * at the add call, so callers can add unconditionally; use is_active() to
+ * skip gathering work that is only needed for debug output.
+ */
+class Debug_draw
+{
+public:
+
+    /** @brief Constructs the layer (enabled with collision bounds in debug builds, disabled in release). */
+    Debug_draw();
+
+    /** @brief Enables or disables the whole layer. */
+    void toggle();
+
+    /** @returns true if the layer is enabled. */
+    FLEV_NODISCARD bool is_enabled() const;
+
+    /** @brief Enables or disables one channel. */
+    void toggle_channel(const Debug_channel channel);
+
+    /** @returns true if the channel is enabled (regardless of the layer). */
+    FLEV_NODISCARD bool is_channel_enabled(const Debug_channel channel) const;
+
+    /** @returns true if geometry added to the channel will be drawn. */
+    FLEV_NODISCARD bool is_active(const Debug_channel channel) const;
+
+    /** @brief Appends a line segment. */
+    void add_line(const Debug_channel channel, const sf::Vector2f& from, const sf::Vector2f& to, const sf::Color color);
+
+    /** @brief Appends a rectangle outline. */
+    void add_box(const Debug_channel channel, const sf::FloatRect& box, const sf::Color color);
+
+    /** @brief Appends an axis-aligned cross centered at the given point. */
+    void add_cross(const Debug_channel channel, const sf::Vector2f& center, const float half_size, const sf::Color color);
+
+    /** @brief Draws collected geometry with one draw call and clears it. */
+    void flush(sf::RenderTarget& render_target);
+
+private/*vars*/:
+
+    sf::VertexArray lines_;                                  ///< Two vertices per segment.
+    bool enabled_;                                           ///< Layer switch.
+    std::array<bool, debug_channel_count> channels_{};       ///< Channel switches (see Debug_channel).
+};
+
+/** @returns Debug geometry layer shared by all scenes (main thread only). */
+FLEV_NODISCARD Debug_draw& get_debug_draw();
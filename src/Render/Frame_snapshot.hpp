@@ -0,0 +1,99 @@
+#pragma once
+#include <utils/defines.hpp>
+#include <Resources/Resource_manager.hpp>
+#include <SFML/Graphics.hpp>
+#include <cassert>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+/**
+ * @brief Immutable copy of everything drawn in one frame.
+ *
+ * The simulation thread records drawables into a snapshot (see
+ * draw_counted()), then hands it to Render_thread, which replays it while
+ * the next frame is being simulated. Drawables are copied by value; the
+ * textures they point to must outlive the frame. Text copies are switched to
+ * the render thread twin of their font (see Resource_manager::get_render_font()),
+ * because laying out glyphs writes to the font while the main thread keeps
+ * using it for the next frame.
+ *
+ * clear() keeps recorded slots, so re-recording a drawable of the same kind
+ * into a slot reuses its storage (vertex arrays do not reallocate).
+ */
+class Frame_snapshot
+{
+public:
+
+    /** @brief Drawable kinds scenes and UI submit. */
+    using Drawable = std::variant<sf::Sprite, sf::Text, sf::RectangleShape, sf::VertexArray>;
+
+    /** @brief Forgets recorded commands (keeps their storage). */
+    void clear() { count_ = 0u; }
+
+    /** @returns Number of recorded draw calls. */
+    FLEV_NODISCARD size_t size() const { return count_; }
+
+    /** @brief Records a copy of the drawable with its render states. */
+    template <typename T>
+    void add(const T& drawable, const sf::RenderStates& states)
+    {
+        static_assert(std::is_constructible_v<Drawable, const T&>, "Drawable kind is not supported by Frame_snapshot.");
+        if constexpr (std::is_same_v<T, sf::Text>)
+        {
+            // The copy rebuilds its glyphs from the twin font on the render thread
+            auto& copy = store(drawable, states);
+            const auto* render_font = get_resource_manager().get_render_font(drawable.getFont());
+            assert(render_font && "Recorded text must use a font from Resource_manager");
+            if (render_font) copy.setFont(*render_font);
+        }
+        else
+        {
+            (void)store(drawable, states);
+        }
+    }//!add
+
+    /** @brief Draws recorded commands in order. */
+    void draw(sf::RenderTarget& render_target) const
+    {
+        for (size_t i = 0; i < count_; ++i)
+        {
+            const auto& command = commands_[i];
+            std::visit([&](const auto& drawable) { render_target.draw(drawable, command.states); }, command.drawable);
+        }
+    }//!draw
+
+private:
+
+    /** @returns Copy of the drawable stored in the next slot (reusing the slot's storage). */
+    template <typename T>
+    T& store(const T& drawable, const sf::RenderStates& states)
+    {
+        if (count_ == commands_.size()) commands_.push_back({ Drawable(std::in_place_type<T>, drawable), states });
+        auto& command = commands_[count_++];
+        command.states = states;
+        if (auto* stored = std::get_if<T>(&command.drawable))
+        {
+            *stored = drawable;
+            return *stored;
+        }
+        return command.drawable.template emplace<T>(drawable);
+    }//!store
+
+    /** @brief One recorded draw call. */
+    struct Command
+    {
+        Drawable drawable;       ///< Copy of the drawable.
+        sf::RenderStates states; ///< States it was drawn with.
+    };
+
+    std::vector<Command> commands_; ///< Recorded slots (first count_ are valid).
+    size_t count_ = 0u;             ///< Commands of the current frame.
+};
+
+/** @returns Snapshot draw_counted() records into (nullptr draws immediately). Main thread only. */
+FLEV_NODISCARD inline Frame_snapshot*& get_recording_snapshot()
+{
+    static Frame_snapshot* snapshot = nullptr;
+    return snapshot;
+}//!get_recording_snapshot
@@ -0,0 +1,38 @@
+#pragma once
+#include <utils/defines.hpp>
+#include "Frame_snapshot.hpp"
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+
+/** @brief Rendering counters of the current frame (main thread only, reset by Main_window). */
+struct Render_stats
+{
+    uint32_t draw_calls = 0u; ///< Drawables submitted through draw_counted().
+    uint64_t vertices = 0u;   ///< Vertices submitted by vertex array draws.
+};
+
+/** @returns Counters of the current frame. */
+FLEV_NODISCARD inline Render_stats& get_render_stats()
+{
+    static Render_stats render_stats;
+    return render_stats;
+}//!get_render_stats
+
+/**
+ * @brief Draws a drawable and counts it as one draw call.
+ *
+ * SFML has no draw call counter, so all scene and UI drawing goes through here.
+ * While a frame is being recorded (see get_recording_snapshot()) the drawable
+ * is copied into the snapshot instead and drawn later by the render thread.
+ */
+template <typename T>
+inline void draw_counted(
+    sf::RenderTarget& render_target,
+    const T& drawable,
+    const sf::RenderStates& states = sf::RenderStates::Default
+)
+{
+    ++get_render_stats().draw_calls;
+    if (auto* snapshot = get_recording_snapshot()) snapshot->add(drawable, states);
+    else render_target.draw(drawable, states);
+}//!draw_counted
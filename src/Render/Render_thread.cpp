@@ -0,0 +1,89 @@
+#include "Render_thread.hpp"
+#include <utils/logger.hpp>
+#include <utils/profiler.hpp>
+
+Render_thread::Render_thread(sf::RenderWindow& window)
+    : window_(window)
+{
+    if (!window_.setActive(false))
+    {
+        LOG_ERROR(get_global_logger(), "Failed to release the window context for the render thread.");
+    }
+    thread_ = std::thread([this] { run(); });
+}//!Render_thread
+//---------------------------------------------------------------------------------------
+
+Render_thread::~Render_thread() noexcept
+{
+    {
+        std::lock_guard lock(mutex_);
+        stopping_ = true;
+    }
+    state_changed_.notify_all();
+    thread_.join();
+    (void)window_.setActive(true);
+}//!~Render_thread
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD Frame_snapshot& Render_thread::get_back_buffer()
+{
+    return buffers_[back_];
+}//!get_back_buffer
+//---------------------------------------------------------------------------------------
+
+void Render_thread::present()
+{
+    {
+        std::unique_lock lock(mutex_);
+        state_changed_.wait(lock, [this] { return !frame_pending_; });
+        back_ ^= 1u;
+        frame_pending_ = true;
+    }
+    state_changed_.notify_all();
+}//!present
+//---------------------------------------------------------------------------------------
+
+void Render_thread::wait_idle()
+{
+    std::unique_lock lock(mutex_);
+    state_changed_.wait(lock, [this] { return !frame_pending_; });
+}//!wait_idle
+//---------------------------------------------------------------------------------------
+
+void Render_thread::run()
+{
+    FLEV_PROFILE_THREAD("render");
+    if (!window_.setActive(true))
+    {
+        LOG_ERROR(get_global_logger(), "Failed to activate the window context on the render thread.");
+    }
+
+    while (true)
+    {
+        size_t front = 0u;
+        {
+            std::unique_lock lock(mutex_);
+            state_changed_.wait(lock, [this] { return frame_pending_ || stopping_; });
+            if (!frame_pending_) break; // Stopping with nothing queued
+            front = back_ ^ 1u;
+        }
+
+        {
+            FLEV_PROFILE_ZONE("render frame");
+            window_.clear();
+            buffers_[front].draw(window_);
+        }
+        {
+            FLEV_PROFILE_ZONE("display");
+            window_.display();
+        }
+
+        {
+            std::lock_guard lock(mutex_);
+            frame_pending_ = false;
+        }
+        state_changed_.notify_all();
+    }
+    (void)window_.setActive(false);
+}//!run
+//---------------------------------------------------------------------------------------
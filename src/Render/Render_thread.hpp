@@ -0,0 +1,69 @@
+#pragma once
+#include <utils/defines.hpp>
+#include "Frame_snapshot.hpp"
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+/**
+ * @brief Draws and presents recorded frames on a dedicated thread.
+ *
+ * Holds two snapshots: the main thread records frame N + 1 into the back
+ * buffer while this thread replays frame N from the front buffer and blocks
+ * on vsync in display(). present() swaps them once frame N is on screen, so
+ * at most one frame is in flight and the simulation never waits on the GPU
+ * for longer than one frame.
+ *
+ * The window's GL context belongs to this thread while it runs. The main
+ * thread keeps polling events, uploading textures and drawing to render
+ * textures (SFML gives it its own shared context).
+ */
+class Render_thread
+{
+public:
+
+    /**
+     * @brief Takes over the window's GL context and starts the thread.
+     *
+     * @param window[in] - Window to draw to (must outlive the render thread).
+     */
+    explicit Render_thread(sf::RenderWindow& window);
+
+    /** @brief Finishes the frame in flight, stops the thread and gives the context back to the caller. */
+    ~Render_thread() noexcept;
+
+    Render_thread(const Render_thread&) = delete;
+    Render_thread& operator=(const Render_thread&) = delete;
+
+    /** @returns Snapshot to record the next frame into (main thread only, valid until present()). */
+    FLEV_NODISCARD Frame_snapshot& get_back_buffer();
+
+    /** @brief Waits for the frame in flight, then queues the back buffer for drawing. */
+    void present();
+
+    /**
+     * @brief Blocks until the frame in flight is displayed.
+     *
+     * Call before destroying anything a queued snapshot points to (scene textures, fonts).
+     */
+    void wait_idle();
+
+private/*methods*/:
+
+    /** @brief Thread body: draws queued frames until stopped. */
+    void run();
+
+private/*vars*/:
+
+    sf::RenderWindow& window_;              ///< Presented window.
+    std::array<Frame_snapshot, 2> buffers_; ///< Back (recorded) and front (drawn) snapshots.
+    size_t back_ = 0u;                      ///< Index of the back buffer.
+
+    std::mutex mutex_;                      ///< Guards frame_pending_ and stopping_.
+    std::condition_variable state_changed_; ///< Signals a queued frame, a finished frame or shutdown.
+    bool frame_pending_ = false;            ///< Front buffer is queued or being drawn.
+    bool stopping_ = false;                 ///< Set on destruction.
+    std::thread thread_;                    ///< Render thread (started last).
+};
@@ -0,0 +1,79 @@
+#include "Sprite_batch.hpp"
+#include "Render_stats.hpp"
+#include <cmath>
+
+Sprite_batch::Sprite_batch()
+    : vertices_(sf::PrimitiveType::Triangles)
+{
+}//!Sprite_batch
+//---------------------------------------------------------------------------------------
+
+void Sprite_batch::set_texture(const sf::Texture* texture)
+{
+    texture_ = texture;
+}//!set_texture
+//---------------------------------------------------------------------------------------
+
+void Sprite_batch::clear()
+{
+    vertices_.clear();
+}//!clear
+//---------------------------------------------------------------------------------------
+
+void Sprite_batch::add(
+    const sf::IntRect& region,
+    const sf::Vector2f& center,
+    const sf::Vector2f& scale,
+    const float rotation_deg
+)
+{
+    const sf::Vector2f half_size(region.size.x * scale.x / 2.f, region.size.y * scale.y / 2.f);
+
+    // Corners relative to the center: top-left, top-right, bottom-right, bottom-left
+    sf::Vector2f corners[4] = {
+        { -half_size.x, -half_size.y },
+        {  half_size.x, -half_size.y },
+        {  half_size.x,  half_size.y },
+        { -half_size.x,  half_size.y }
+    };
+    if (rotation_deg != 0.f)
+    {
+        const float rad = rotation_deg * 3.1415926535f / 180.f; // PI
+        const float c = std::cos(rad);
+        const float s = std::sin(rad);
+        for (auto& corner : corners)
+        {
+            corner = { corner.x * c - corner.y * s, corner.x * s + corner.y * c };
+        }
+    }
+
+    const sf::Vector2f tex_min(region.position);
+    const sf::Vector2f tex_max(region.position + region.size);
+    const sf::Vector2f tex_coords[4] = {
+        { tex_min.x, tex_min.y },
+        { tex_max.x, tex_min.y },
+        { tex_max.x, tex_max.y },
+        { tex_min.x, tex_max.y }
+    };
+
+    // Two triangles: 0-1-2 and 0-2-3
+    for (const auto i : { 0, 1, 2, 0, 2, 3 })
+    {
+        vertices_.append(sf::Vertex{ center + corners[i], sf::Color::White, tex_coords[i] });
+    }
+}//!add
+//---------------------------------------------------------------------------------------
+
+void Sprite_batch::draw(sf::RenderTarget& render_target) const
+{
+    if (vertices_.getVertexCount() == 0 || !texture_) return;
+    get_render_stats().vertices += vertices_.getVertexCount();
+    draw_counted(render_target, vertices_, sf::RenderStates(texture_));
+}//!draw
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD size_t Sprite_batch::get_quad_count() const
+{
+    return vertices_.getVertexCount() / 6u;
+}//!get_quad_count
+//---------------------------------------------------------------------------------------
@@ -0,0 +1,49 @@
+#pragma once
+#include <utils/defines.hpp>
+#include <SFML/Graphics.hpp>
+
+/**
+ * @brief Collects textured quads from one texture and draws them in a single call.
+ *
+ * Quads are appended every frame with add() and drawn in insertion order.
+ * clear() keeps the vertex storage, so a steady-state frame does not allocate.
+ */
+class Sprite_batch
+{
+public:
+
+    /** @brief Constructs an empty batch (texture must be set before drawing). */
+    Sprite_batch();
+
+    /** @brief Sets the texture all quads are sampled from (usually an atlas). */
+    void set_texture(const sf::Texture* texture);
+
+    /** @brief Removes all quads. */
+    void clear();
+
+    /**
+     * @brief Appends a sprite quad.
+     *
+     * @param region[in]            - Texture rectangle (pixels).
+     * @param center[in]            - Position of the sprite center.
+     * @param scale[in]             - Sprite scale.
+     * @param rotation_deg[in][opt] - Rotation around the center in degrees. [Default: 0]
+     */
+    void add(
+        const sf::IntRect& region,
+        const sf::Vector2f& center,
+        const sf::Vector2f& scale,
+        const float rotation_deg = 0.f
+    );
+
+    /** @brief Draws all quads with one draw call (nothing if empty). */
+    void draw(sf::RenderTarget& render_target) const;
+
+    /** @returns Number of quads in the batch. */
+    FLEV_NODISCARD size_t get_quad_count() const;
+
+private/*vars*/:
+
+    sf::VertexArray vertices_;             ///< Two triangles per quad.
+    const sf::Texture* texture_ = nullptr; ///< Texture of all quads.
+};
@@ -0,0 +1,108 @@
+#include "Texture_atlas.hpp"
+#include <utils/logger.hpp>
+#include <algorithm>
+#include <numeric>
+#include <bit>
+#include <cmath>
+
+Texture_atlas::Region_id Texture_atlas::add(const sf::Image& image)
+{
+    pending_images_.push_back(image);
+    regions_.emplace_back(sf::Vector2i{}, sf::Vector2i(image.getSize()));
+    masks_.emplace_back(image);
+    return static_cast<Region_id>(regions_.size() - 1);
+}//!add
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD bool Texture_atlas::build()
+{
+    const auto max_size = sf::Texture::getMaximumSize();
+
+    // Start from a square of the total area and widen until the shelves fit
+    uint64_t area = 0u;
+    uint32_t width = 1u;
+    for (const auto& region : regions_)
+    {
+        area += static_cast<uint64_t>(region.size.x + padding_) * static_cast<uint64_t>(region.size.y + padding_);
+        width = std::max(width, static_cast<uint32_t>(region.size.x + padding_));
+    }
+    width = std::max(width, static_cast<uint32_t>(std::sqrt(static_cast<double>(area))));
+    width = std::bit_ceil(width);
+
+    uint32_t height = pack_shelves(width);
+    while (height > max_size && width < max_size)
+    {
+        width *= 2u;
+        height = pack_shelves(width);
+    }
+    if (width > max_size || height > max_size)
+    {
+        LOG_ERROR(get_global_logger(), "Atlas of {}x{} exceeds maximum texture size {}.", width, height, max_size);
+        return false;
+    }
+
+    sf::Image atlas_image;
+    atlas_image.resize({ width, std::max(height, 1u) }, sf::Color::Transparent);
+    for (size_t i = 0; i < regions_.size(); ++i)
+    {
+        if (regions_[i].size.x == 0 || regions_[i].size.y == 0) continue;
+        if (!atlas_image.copy(pending_images_[i], sf::Vector2u(regions_[i].position)))
+        {
+            LOG_ERROR(get_global_logger(), "Failed to copy image {} into atlas.", i);
+        }
+    }
+    pending_images_.clear();
+
+    if (!texture_.loadFromImage(atlas_image))
+    {
+        LOG_ERROR(get_global_logger(), "Failed to upload {}x{} atlas texture.", width, height);
+        return false;
+    }
+    return true;
+}//!build
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD const sf::Texture& Texture_atlas::get_texture() const
+{
+    return texture_;
+}//!get_texture
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD const sf::IntRect& Texture_atlas::get_region(const Region_id id) const
+{
+    return regions_[id];
+}//!get_region
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD const Collision_mask& Texture_atlas::get_mask(const Region_id id) const
+{
+    return masks_[id];
+}//!get_mask
+//---------------------------------------------------------------------------------------
+
+uint32_t Texture_atlas::pack_shelves(const uint32_t width)
+{
+    // Tallest first keeps shelves tight
+    std::vector<size_t> order(regions_.size());
+    std::iota(order.begin(), order.end(), size_t{ 0 });
+    std::sort(order.begin(), order.end(), [this](const size_t lhs, const size_t rhs) {
+        return regions_[lhs].size.y > regions_[rhs].size.y;
+    });
+
+    sf::Vector2i cursor;
+    int32_t shelf_height = 0;
+    for (const auto i : order)
+    {
+        auto& region = regions_[i];
+        if (cursor.x + region.size.x + padding_ > static_cast<int32_t>(width))
+        {
+            cursor = { 0, cursor.y + shelf_height };
+            shelf_height = 0;
+        }
+        region.position = cursor;
+        cursor.x += region.size.x + padding_;
+        shelf_height = std::max(shelf_height, region.size.y + padding_);
+    }
+    return static_cast<uint32_t>(cursor.y + shelf_height);
+}//!pack_shelves
+//---------------------------------------------------------------------------------------
@@ -0,0 +1,63 @@
+#pragma once
+#include <utils/defines.hpp>
+#include <utils/collision_mask.hpp>
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include <cstdint>
+
+/**
+ * @brief Several images packed into one texture.
+ *
+ * Images are copied on add() and packed into a single texture by build()
+ * (shelf packing, tallest first). Sprites sharing the atlas can then be
+ * drawn with one texture bind, see Sprite_batch. The alpha channel of every
+ * image is kept as a Collision_mask for pixel-accurate collisions.
+ */
+class Texture_atlas
+{
+public:
+    using Region_id = uint32_t;
+
+    /**
+     * @brief Copies a decoded image, builds its collision mask and queues it for packing.
+     *
+     * @param image[in] - Image to pack (e.g. from Resource_manager::get_image()).
+     *
+     * @returns Id of the image region (valid after build()). An empty image yields an empty region.
+     */
+    Region_id add(const sf::Image& image);
+
+    /**
+     * @brief Packs all added images into the atlas texture and frees decoded images.
+     *
+     * @returns false if the images do not fit into the maximum texture size or upload failed.
+     */
+    FLEV_NODISCARD bool build();
+
+    /** @returns Atlas texture. */
+    FLEV_NODISCARD const sf::Texture& get_texture() const;
+
+    /** @returns Pixel rectangle of the given image inside the atlas texture. */
+    FLEV_NODISCARD const sf::IntRect& get_region(const Region_id id) const;
+
+    /** @returns Collision mask of the given image at texture resolution (empty if the load failed). */
+    FLEV_NODISCARD const Collision_mask& get_mask(const Region_id id) const;
+
+private/*methods*/:
+
+    /**
+     * @brief Places all regions on shelves of the given width.
+     *
+     * @returns Resulting atlas height.
+     */
+    uint32_t pack_shelves(const uint32_t width);
+
+private/*vars*/:
+
+    static constexpr int32_t padding_ = 2;  ///< Empty pixels between images (no bleeding when sampling).
+
+    sf::Texture texture_;                   ///< Packed texture.
+    std::vector<sf::IntRect> regions_;      ///< Region of each image in the atlas.
+    std::vector<Collision_mask> masks_;     ///< Alpha mask of each image.
+    std::vector<sf::Image> pending_images_; ///< Decoded images waiting for build().
+};
@@ -0,0 +1,254 @@
+#include "Resource_manager.hpp"
+#include <utils/logger.hpp>
+#include <utils/profiler.hpp>
+#include <fstream>
+#include <iterator>
+#include <chrono>
+
+Resource_manager::Resource_manager()
+    : worker_(&Resource_manager::worker_loop, this)
+{
+}//!Resource_manager
+//---------------------------------------------------------------------------------------
+
+Resource_manager::~Resource_manager()
+{
+    {
+        std::lock_guard lock(queue_mutex_);
+        stop_ = true;
+    }
+    queue_cv_.notify_one();
+    if (worker_.joinable()) worker_.join();
+}//!~Resource_manager
+//---------------------------------------------------------------------------------------
+
+void Resource_manager::preload_texture(const std::string& path)
+{
+    unclaimed_.insert(path);
+    if (textures_.contains(path) || pending_textures_.contains(path)) return;
+
+    pending_textures_.emplace(path, enqueue_decode(path));
+}//!preload_texture
+//---------------------------------------------------------------------------------------
+
+void Resource_manager::preload_image(const std::string& path)
+{
+    unclaimed_.insert(path);
+    if (images_.contains(path) || pending_images_.contains(path)) return;
+
+    pending_images_.emplace(path, enqueue_decode(path));
+}//!preload_image
+//---------------------------------------------------------------------------------------
+
+void Resource_manager::preload_font(const std::string& path)
+{
+    unclaimed_.insert(path);
+    if (fonts_.contains(path) || pending_fonts_.contains(path)) return;
+
+    auto task = std::make_shared<std::packaged_task<std::vector<std::byte>()>>([path] {
+        FLEV_PROFILE_ZONE("read font");
+        std::vector<std::byte> data;
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+        {
+            LOG_ERROR(get_global_logger(), "Failed to load font from path: {}", path);
+            return data;
+        }
+        file.seekg(0, std::ios::end);
+        data.resize(static_cast<size_t>(file.tellg()));
+        file.seekg(0, std::ios::beg);
+        file.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()));
+        return data;
+    });
+    pending_fonts_.emplace(path, task->get_future());
+    enqueue([task] { (*task)(); });
+}//!preload_font
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD Texture_handle Resource_manager::get_texture(const std::string& path)
+{
+    unclaimed_.erase(path);
+    if (const auto it = textures_.find(path); it != textures_.end()) return it->second;
+
+    auto pending = pending_textures_.find(path);
+    if (pending == pending_textures_.end()) pending = pending_textures_.emplace(path, enqueue_decode(path)).first;
+    return finish_texture(path, pending->second);
+}//!get_texture
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD Image_handle Resource_manager::get_image(const std::string& path)
+{
+    unclaimed_.erase(path);
+    if (const auto it = images_.find(path); it != images_.end()) return it->second;
+
+    auto pending = pending_images_.find(path);
+    if (pending == pending_images_.end()) pending = pending_images_.emplace(path, enqueue_decode(path)).first;
+    return finish_image(path, pending->second);
+}//!get_image
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD Font_handle Resource_manager::get_font(const std::string& path)
+{
+    if (const auto it = fonts_.find(path); it != fonts_.end())
+    {
+        unclaimed_.erase(path);
+        return Font_handle(it->second, &it->second->font);
+    }
+
+    preload_font(path);
+    unclaimed_.erase(path);
+    return finish_font(path, pending_fonts_.at(path));
+}//!get_font
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD const sf::Font* Resource_manager::get_render_font(const sf::Font& font) const
+{
+    for (const auto& [path, resource] : fonts_)
+    {
+        if (&resource->font == &font) return &resource->render_font;
+    }
+    return nullptr;
+}//!get_render_font
+//---------------------------------------------------------------------------------------
+
+void Resource_manager::process_ready()
+{
+    const auto is_ready = [](const auto& future) {
+        return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    };
+
+    std::vector<std::string> ready;
+    for (auto& [path, pending] : pending_textures_)
+    {
+        if (is_ready(pending)) ready.push_back(path);
+    }
+    for (const auto& path : ready) (void)finish_texture(path, pending_textures_.at(path));
+
+    ready.clear();
+    for (auto& [path, pending] : pending_images_)
+    {
+        if (is_ready(pending)) ready.push_back(path);
+    }
+    for (const auto& path : ready) (void)finish_image(path, pending_images_.at(path));
+
+    ready.clear();
+    for (auto& [path, pending] : pending_fonts_)
+    {
+        if (is_ready(pending)) ready.push_back(path);
+    }
+    for (const auto& path : ready) (void)finish_font(path, pending_fonts_.at(path));
+}//!process_ready
+//---------------------------------------------------------------------------------------
+
+void Resource_manager::release_unused()
+{
+    const auto is_unused = [this](const auto& entry) {
+        return entry.second.use_count() == 1 && !unclaimed_.contains(entry.first);
+    };
+    std::erase_if(textures_, is_unused);
+    std::erase_if(images_, is_unused);
+    std::erase_if(fonts_, is_unused);
+}//!release_unused
+//---------------------------------------------------------------------------------------
+
+sf::Image Resource_manager::decode_image(const std::string& path)
+{
+    FLEV_PROFILE_ZONE("decode image");
+    sf::Image image;
+    if (!image.loadFromFile(path))
+    {
+        LOG_ERROR(get_global_logger(), "Failed to load image from path: {}", path);
+    }
+    return image;
+}//!decode_image
+//---------------------------------------------------------------------------------------
+
+std::future<sf::Image> Resource_manager::enqueue_decode(const std::string& path)
+{
+    auto task = std::make_shared<std::packaged_task<sf::Image()>>([path] { return decode_image(path); });
+    auto future = task->get_future();
+    enqueue([task] { (*task)(); });
+    return future;
+}//!enqueue_decode
+//---------------------------------------------------------------------------------------
+
+void Resource_manager::enqueue(std::function<void()> job)
+{
+    {
+        std::lock_guard lock(queue_mutex_);
+        jobs_.push_back(std::move(job));
+    }
+    queue_cv_.notify_one();
+}//!enqueue
+//---------------------------------------------------------------------------------------
+
+void Resource_manager::worker_loop()
+{
+    FLEV_PROFILE_THREAD("resource worker");
+    while (true)
+    {
+        std::function<void()> job;
+        {
+            std::unique_lock lock(queue_mutex_);
+            queue_cv_.wait(lock, [this] { return stop_ || !jobs_.empty(); });
+            if (jobs_.empty()) return; // Stopped and drained
+            job = std::move(jobs_.front());
+            jobs_.pop_front();
+        }
+        job();
+    }
+}//!worker_loop
+//---------------------------------------------------------------------------------------
+
+Texture_handle Resource_manager::finish_texture(const std::string& path, std::future<sf::Image>& pending)
+{
+    FLEV_PROFILE_FUNCTION();
+    const auto image = pending.get();
+    pending_textures_.erase(path);
+
+    // Upload must happen on the thread owning the GL context
+    auto texture = std::make_shared<sf::Texture>();
+    if (image.getSize().x > 0 && image.getSize().y > 0 && !texture->loadFromImage(image))
+    {
+        LOG_ERROR(get_global_logger(), "Failed to upload texture: {}", path);
+    }
+    textures_[path] = texture;
+    return texture;
+}//!finish_texture
+//---------------------------------------------------------------------------------------
+
+Image_handle Resource_manager::finish_image(const std::string& path, std::future<sf::Image>& pending)
+{
+    FLEV_PROFILE_FUNCTION();
+    auto image = std::make_shared<const sf::Image>(pending.get());
+    pending_images_.erase(path);
+    images_[path] = image;
+    return image;
+}//!finish_image
+//---------------------------------------------------------------------------------------
+
+Font_handle Resource_manager::finish_font(const std::string& path, std::future<std::vector<std::byte>>& pending)
+{
+    FLEV_PROFILE_FUNCTION();
+    auto resource = std::make_shared<Font_resource>();
+    resource->data = pending.get();
+    pending_fonts_.erase(path);
+
+    if (!resource->data.empty() && (
+        !resource->font.openFromMemory(resource->data.data(), resource->data.size()) ||
+        !resource->render_font.openFromMemory(resource->data.data(), resource->data.size())
+    ))
+    {
+        LOG_ERROR(get_global_logger(), "Failed to open font: {}", path);
+    }
+    fonts_[path] = resource;
+    return Font_handle(resource, &resource->font);
+}//!finish_font
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD Resource_manager& get_resource_manager()
+{
+    static Resource_manager resource_manager;
+    return resource_manager;
+}//!get_resource_manager
+//---------------------------------------------------------------------------------------
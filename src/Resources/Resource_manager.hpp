@@ -0,0 +1,143 @@
+#pragma once
+#include <utils/defines.hpp>
+#include <SFML/Graphics.hpp>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <thread>
+#include <memory>
+#include <string>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <map>
+#include <set>
+
+using Texture_handle = std::shared_ptr<const sf::Texture>; ///< Shared texture (stable while held).
+using Font_handle = std::shared_ptr<const sf::Font>;       ///< Shared font (stable while held).
+using Image_handle = std::shared_ptr<const sf::Image>;     ///< Shared decoded image (CPU side, e.g. for atlas packing).
+
+/**
+ * @brief Shared cache of textures, images and fonts, deduplicated by path.
+ *
+ * Files are read and decoded on a worker thread; GPU upload and font setup
+ * happen on the calling (main) thread. Images stay on the CPU for callers
+ * that build their own textures (e.g. Texture_atlas). preload() queues work ahead of time,
+ * get_*() returns a ready resource, waiting for a queued decode if needed.
+ *
+ * Handles are reference counted. The cache keeps its own reference, so a
+ * resource survives until release_unused() finds it held by nobody else
+ * (Main_window calls it after every scene switch). Preloaded resources are
+ * kept until they have been requested once, so assets queued for a later
+ * scene survive the switches before it. A failed load logs an error and
+ * yields an empty resource.
+ */
+class Resource_manager
+{
+public:
+
+    /** @brief Starts the decode worker. */
+    Resource_manager();
+
+    /** @brief Stops the decode worker (queued decodes are finished first). */
+    ~Resource_manager();
+
+    Resource_manager(const Resource_manager&) = delete;
+    Resource_manager& operator=(const Resource_manager&) = delete;
+
+    /** @brief Queues decoding of a texture image and keeps the texture until requested (no decode if cached or queued). */
+    void preload_texture(const std::string& path);
+
+    /** @brief Queues decoding of an image and keeps it until requested (no decode if cached or queued). */
+    void preload_image(const std::string& path);
+
+    /** @brief Queues reading of a font file and keeps the font until requested (no read if cached or queued). */
+    void preload_font(const std::string& path);
+
+    /** @returns Texture loaded from the given path (waits for a queued decode). */
+    FLEV_NODISCARD Texture_handle get_texture(const std::string& path);
+
+    /** @returns Image decoded from the given path (waits for a queued decode). */
+    FLEV_NODISCARD Image_handle get_image(const std::string& path);
+
+    /** @returns Font loaded from the given path (waits for a queued read). */
+    FLEV_NODISCARD Font_handle get_font(const std::string& path);
+
+    /**
+     * @brief Render thread twin of a managed font.
+     *
+     * Laying out text loads glyphs into the font (its page map and page
+     * textures change), so a font must never be used by two threads at once.
+     * Every managed font is opened twice: the returned instance is meant for
+     * the render thread only, the one from get_font() for everything else.
+     *
+     * @param font[in] - Font returned by get_font().
+     *
+     * @returns Twin font, or nullptr if the font is not managed.
+     */
+    FLEV_NODISCARD const sf::Font* get_render_font(const sf::Font& font) const;
+
+    /** @brief Uploads textures, caches images and opens fonts whose decode has finished (call once per frame). */
+    void process_ready();
+
+    /** @brief Drops cached resources not held by anyone else (preloads not yet requested are kept). */
+    void release_unused();
+
+private/*types*/:
+
+    /** @brief Font with the file data it reads glyphs from. */
+    struct Font_resource
+    {
+        std::vector<std::byte> data; ///< Font file contents (must outlive both fonts).
+        sf::Font font;               ///< Font opened from data (main thread).
+        sf::Font render_font;        ///< Second instance opened from data (render thread, see get_render_font()).
+    };
+
+private/*methods*/:
+
+    /** @brief Decodes an image file (worker thread; a failed load logs an error and yields an empty image). */
+    static sf::Image decode_image(const std::string& path);
+
+    /** @brief Queues decode_image() on the worker and returns its result. */
+    std::future<sf::Image> enqueue_decode(const std::string& path);
+
+    /** @brief Runs the given job on the worker thread. */
+    void enqueue(std::function<void()> job);
+
+    /** @brief Worker loop: executes queued jobs until stopped. */
+    void worker_loop();
+
+    /** @brief Creates the texture of a finished decode and caches it. */
+    Texture_handle finish_texture(const std::string& path, std::future<sf::Image>& pending);
+
+    /** @brief Caches the image of a finished decode. */
+    Image_handle finish_image(const std::string& path, std::future<sf::Image>& pending);
+
+    /** @brief Opens the font of a finished read and caches it. */
+    Font_handle finish_font(const std::string& path, std::future<std::vector<std::byte>>& pending);
+
+private/*vars*/:
+
+    // -----------------------------------------------------------------------
+    // Cache (main thread only)
+    // -----------------------------------------------------------------------
+    std::map<std::string, std::shared_ptr<const sf::Texture>> textures_;           ///< Uploaded textures by path.
+    std::map<std::string, std::shared_ptr<const sf::Image>> images_;               ///< Decoded images by path.
+    std::map<std::string, std::shared_ptr<const Font_resource>> fonts_;            ///< Opened fonts by path.
+    std::map<std::string, std::future<sf::Image>> pending_textures_;               ///< Texture decodes in flight.
+    std::map<std::string, std::future<sf::Image>> pending_images_;                 ///< Image decodes in flight.
+    std::map<std::string, std::future<std::vector<std::byte>>> pending_fonts_;     ///< Font reads in flight.
+    std::set<std::string> unclaimed_;                                              ///< Preloaded paths not requested yet (kept by release_unused).
+
+    // -----------------------------------------------------------------------
+    // Worker
+    // -----------------------------------------------------------------------
+    std::mutex queue_mutex_;                ///< Guards jobs_ and stop_.
+    std::condition_variable queue_cv_;      ///< Signals new jobs or stop.
+    std::deque<std::function<void()>> jobs_; ///< Queued decode jobs.
+    bool stop_ = false;                     ///< Worker shutdown flag.
+    std::thread worker_;                    ///< Decode thread.
+};
+
+/** @brief Get the global resource manager instance. */
+FLEV_NODISCARD Resource_manager& get_resource_manager();
@@ -146,7 +146,7 @@ void Button::update_visuals()
 
 void Button::draw(sf::RenderTarget& render_target) const
 {
-    render_target.draw(body_);
-    render_target.draw(label_);
+    draw_counted(render_target, body_);
+    draw_counted(render_target, label_);
 }//!draw
 //---------------------------------------------------------------------------------------
\ No newline at end of file
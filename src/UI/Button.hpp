@@ -1,6 +1,7 @@
 #pragma once
 #include <utils/defines.hpp>
 #include <SFML/Graphics.hpp>
+#include <Render/Render_stats.hpp>
 
 class Button
 {
@@ -1,5 +1,4 @@
 #include "Decorated_panel.hpp"
-#include <vector>
 
 Decorated_panel::Decorated_panel(
     const std::string& texture_path,
@@ -7,17 +6,14 @@ Decorated_panel::Decorated_panel(
 )
     : Panel(size, sf::Color::Transparent)
 {
-    static std::vector<std::unique_ptr<sf::Texture>> textures;
-
-    auto texture = std::make_unique<sf::Texture>();
-    if (!texture->loadFromFile(texture_path))
+    texture_ = get_resource_manager().get_texture(texture_path);
+    if (texture_->getSize().x == 0)
     {
 		LOG_ERROR(get_global_logger(), "Failed to load decorated panel texture: {}", texture_path);
         return;
     }
 
-    background_sprite_ = std::make_unique<sf::Sprite>(*texture);
-    textures.push_back(std::move(texture));
+    background_sprite_ = std::make_unique<sf::Sprite>(*texture_);
 
     set_size(size);
 }//!Decorated_panel
@@ -107,8 +103,8 @@ void Decorated_panel::set_title(const std::string& title, const sf::Font& font,
 
 void Decorated_panel::draw(sf::RenderTarget& render_target) const
 {
-    if (background_sprite_) render_target.draw(*background_sprite_);
-    if (title_text_)        render_target.draw(*title_text_);
+    if (background_sprite_) draw_counted(render_target, *background_sprite_);
+    if (title_text_)        draw_counted(render_target, *title_text_);
 }//!draw
 //---------------------------------------------------------------------------------------
 
@@ -1,5 +1,6 @@
 #pragma once
 #include "Panel.hpp"
+#include <Resources/Resource_manager.hpp>
 
 /** @brief Panel with background texture and optional title. */
 class Decorated_panel : public Panel
@@ -31,6 +32,7 @@ public:
 
 private:
 
+	Texture_handle texture_;                        ///< Background texture (shared between panels).
 	std::unique_ptr<sf::Sprite> background_sprite_; ///< Background sprite.
 	std::unique_ptr<sf::Text> title_text_;          ///< Title text.
 
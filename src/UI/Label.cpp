@@ -8,7 +8,7 @@ Label::Label(const std::string& text, const sf::Font& font, uint32_t char_size)
 }//!Label
 //---------------------------------------------------------------------------------------
 
-void Label::set_text(const std::string& text)
+void Label::set_text(std::string_view text)
 {
     if(text_) text_->setString(sf::String::fromUtf8(text.begin(), text.end()));
 }//!set_text
@@ -41,7 +41,7 @@ void Label::set_font(const sf::Font& font)
 
 void Label::draw(sf::RenderTarget& render_target) const
 {
-    render_target.draw(*text_);
+    draw_counted(render_target, *text_);
 }//!draw
 //---------------------------------------------------------------------------------------
 
@@ -1,7 +1,9 @@
 #pragma once
 #include <utils/defines.hpp>
 #include <SFML/Graphics.hpp>
+#include <Render/Render_stats.hpp>
 #include <string>
+#include <string_view>
 
 /** @brief Simple text label with position, color and font. */
 class Label
@@ -19,8 +21,8 @@ public:
      */
     Label(const std::string& text, const sf::Font& font, uint32_t char_size = 24u);
 
-    /** @brief Sets the displayed text (supports std::to_string, etc.). */
-    void set_text(const std::string& text);
+    /** @brief Sets the displayed UTF-8 text (any string type, including pmr strings). */
+    void set_text(std::string_view text);
 
     /** @brief Sets position (top-left corner). */
     void set_position(const sf::Vector2f& position);
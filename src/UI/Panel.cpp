@@ -28,7 +28,7 @@ void Panel::set_fill_color(sf::Color color)
 
 void Panel::draw(sf::RenderTarget& render_target) const
 {
-    if (background_) render_target.draw(*background_);
+    if (background_) draw_counted(render_target, *background_);
 }//!draw
 //---------------------------------------------------------------------------------------
 
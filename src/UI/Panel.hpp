@@ -2,6 +2,7 @@
 #include <utils/defines.hpp>
 #include <utils/logger.hpp>
 #include <SFML/Graphics.hpp>
+#include <Render/Render_stats.hpp>
 #include <memory>
 
 /** @brief Basic semi-transparent background panel (no texture). */
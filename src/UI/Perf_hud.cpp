@@ -0,0 +1,135 @@
+#include "Perf_hud.hpp"
+#include <Render/Render_stats.hpp>
+#include <algorithm>
+#include <format>
+
+namespace
+{
+    /** @brief Appends an axis-aligned quad as two triangles. */
+    void append_quad(sf::VertexArray& vertices, const sf::FloatRect& rect, const sf::Color color)
+    {
+        const auto min = rect.position;
+        const auto max = rect.position + rect.size;
+        const sf::Vector2f corners[6] = {
+            { min.x, min.y }, { max.x, min.y }, { max.x, max.y },
+            { min.x, min.y }, { max.x, max.y }, { min.x, max.y }
+        };
+        for (const auto& corner : corners) vertices.append(sf::Vertex{ corner, color });
+    }//!append_quad
+}
+
+Perf_hud::Perf_hud(const sf::Vector2f& position)
+    : position_(position)
+    , font_(get_resource_manager().get_font("assets/timesnewromanpsmt.ttf"))
+    , text_(std::make_unique<sf::Text>(*font_, "", 16u))
+    , vertices_(sf::PrimitiveType::Triangles)
+{
+    text_->setFillColor(sf::Color::White);
+    text_->setPosition({ position_.x + padding_, position_.y + padding_ + graph_height_ + padding_ });
+}//!Perf_hud
+//---------------------------------------------------------------------------------------
+
+void Perf_hud::toggle()
+{
+    visible_ = !visible_;
+    if (visible_) rebuild_text();
+}//!toggle
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD bool Perf_hud::is_visible() const
+{
+    return visible_;
+}//!is_visible
+//---------------------------------------------------------------------------------------
+
+void Perf_hud::add_frame(const Frame_timing& timing, const uint32_t draw_calls, std::span<const Hud_counter> counters)
+{
+    history_[next_sample_] = timing;
+    next_sample_ = (next_sample_ + 1u) % history_size_;
+    sample_count_ = std::min(sample_count_ + 1u, history_size_);
+    draw_calls_ = draw_calls;
+    counters_.assign(counters.begin(), counters.end());
+}//!add_frame
+//---------------------------------------------------------------------------------------
+
+void Perf_hud::draw(sf::RenderTarget& render_target)
+{
+    if (!visible_) return;
+
+    if (text_clock_.getElapsedTime().asSeconds() >= text_refresh_s_)
+    {
+        rebuild_text();
+        text_clock_.restart();
+    }
+    rebuild_graph();
+
+    draw_counted(render_target, vertices_);
+    draw_counted(render_target, *text_);
+}//!draw
+//---------------------------------------------------------------------------------------
+
+void Perf_hud::rebuild_graph()
+{
+    vertices_.clear();
+
+    // Background covers graph and text
+    const auto text_bounds = text_->getGlobalBounds();
+    const auto bottom = std::max(text_bounds.position.y + text_bounds.size.y, position_.y + graph_height_) + padding_;
+    append_quad(vertices_, { position_, { graph_width_ + 2.f * padding_, bottom - position_.y } }, sf::Color(0, 0, 0, 180));
+
+    // Stacked bars, oldest on the left: update (green), draw (blue), rest of the frame (grey)
+    const sf::Vector2f origin(position_.x + padding_, position_.y + padding_ + graph_height_);
+    const float bar_width = graph_width_ / static_cast<float>(history_size_);
+    const float px_per_ms = graph_height_ / graph_max_ms_;
+    for (size_t i = 0; i < sample_count_; ++i)
+    {
+        const auto& sample = history_[(next_sample_ + history_size_ - sample_count_ + i) % history_size_];
+        const float x = origin.x + static_cast<float>(history_size_ - sample_count_ + i) * bar_width;
+
+        float y = origin.y;
+        const auto append_bar = [&](const float ms, const sf::Color color) {
+            const float height = std::min(ms * px_per_ms, y - (origin.y - graph_height_));
+            if (height <= 0.f) return;
+            y -= height;
+            append_quad(vertices_, { { x, y }, { bar_width, height } }, color);
+        };
+        append_bar(sample.update_ms, sf::Color(80, 200, 80));
+        append_bar(sample.draw_ms, sf::Color(80, 140, 230));
+        append_bar(sample.frame_ms - sample.update_ms - sample.draw_ms, sf::Color(150, 150, 150));
+    }
+
+    // Target frame time
+    append_quad(vertices_, { { origin.x, origin.y - target_ms_ * px_per_ms }, { graph_width_, 1.f } }, sf::Color::Yellow);
+}//!rebuild_graph
+//---------------------------------------------------------------------------------------
+
+void Perf_hud::rebuild_text()
+{
+    Frame_timing mean;
+    float max_frame_ms = 0.f;
+    for (size_t i = 0; i < sample_count_; ++i)
+    {
+        const auto& sample = history_[i];
+        mean.frame_ms += sample.frame_ms;
+        mean.update_ms += sample.update_ms;
+        mean.draw_ms += sample.draw_ms;
+        max_frame_ms = std::max(max_frame_ms, sample.frame_ms);
+    }
+    const float count = static_cast<float>(std::max<size_t>(sample_count_, 1u));
+    mean.frame_ms /= count;
+    mean.update_ms /= count;
+    mean.draw_ms /= count;
+
+    auto text = std::format(
+        "FPS {:.0f}  frame {:.2f} ms (max {:.2f})\nupdate {:.2f} ms  draw {:.2f} ms\ndraw calls {}",
+        mean.frame_ms > 0.f ? 1000.f / mean.frame_ms : 0.f, mean.frame_ms, max_frame_ms,
+        mean.update_ms, mean.draw_ms,
+        draw_calls_
+    );
+    for (const auto& counter : counters_)
+    {
+        text += std::format("\n{} {}", counter.name, counter.value);
+    }
+    text_->setString(text);
+}//!rebuild_text
+//---------------------------------------------------------------------------------------
@@ -0,0 +1,88 @@
+#pragma once
+#include <utils/defines.hpp>
+#include <Resources/Resource_manager.hpp>
+#include <SFML/Graphics.hpp>
+#include <memory>
+#include <vector>
+#include <array>
+#include <span>
+
+/** @brief Named value shown by the performance HUD (e.g. live entity count). */
+struct Hud_counter
+{
+    const char* name = ""; ///< Counter label (string literal).
+    size_t value = 0u;     ///< Current value.
+};
+
+/** @brief Time split of one frame (milliseconds). */
+struct Frame_timing
+{
+    float frame_ms = 0.f;  ///< Whole frame (loop iteration).
+    float update_ms = 0.f; ///< Fixed-step scene updates.
+    float draw_ms = 0.f;   ///< Scene draw (command submission, excluding display).
+};
+
+/**
+ * @brief Toggleable performance overlay: FPS, frame-time graph, update/draw split and counters.
+ *
+ * The background and graph are one vertex array and all text is one
+ * sf::Text, so the HUD costs two draw calls. Text is re-laid out a few
+ * times per second only. Works in release builds.
+ */
+class Perf_hud
+{
+public:
+
+    /** @brief Constructs hidden HUD anchored at the given top-left position. */
+    explicit Perf_hud(const sf::Vector2f& position);
+
+    /** @brief Shows or hides the HUD. */
+    void toggle();
+
+    /** @returns true if the HUD is shown. */
+    FLEV_NODISCARD bool is_visible() const;
+
+    /**
+     * @brief Adds a finished frame.
+     *
+     * @param timing[in]     - Time split of the frame.
+     * @param draw_calls[in] - Draw calls issued by the scene.
+     * @param counters[in]   - Scene counters (copied).
+     */
+    void add_frame(const Frame_timing& timing, const uint32_t draw_calls, std::span<const Hud_counter> counters);
+
+    /** @brief Draws the HUD (nothing if hidden). */
+    void draw(sf::RenderTarget& render_target);
+
+private/*methods*/:
+
+    /** @brief Rebuilds background and frame-time bars. */
+    void rebuild_graph();
+
+    /** @brief Rebuilds the text block from averaged samples. */
+    void rebuild_text();
+
+private/*vars*/:
+
+    static constexpr size_t history_size_ = 120u;         ///< Frames in the graph.
+    static constexpr float graph_width_ = 300.f;          ///< Graph width in pixels.
+    static constexpr float graph_height_ = 60.f;          ///< Graph height in pixels.
+    static constexpr float graph_max_ms_ = 1000.f / 30.f; ///< Frame time at the top of the graph.
+    static constexpr float target_ms_ = 1000.f / 60.f;    ///< Frame time marked by the target line.
+    static constexpr float padding_ = 8.f;                ///< Inner margin of the background.
+    static constexpr float text_refresh_s_ = 0.25f;       ///< Text update interval (seconds).
+
+    sf::Vector2f position_;                          ///< Top-left corner.
+    bool visible_ = false;                           ///< Shown flag.
+
+    std::array<Frame_timing, history_size_> history_{}; ///< Ring of recent frames.
+    size_t next_sample_ = 0u;                        ///< Ring write position.
+    size_t sample_count_ = 0u;                       ///< Valid samples (up to history_size_).
+    uint32_t draw_calls_ = 0u;                       ///< Draw calls of the last frame.
+    std::vector<Hud_counter> counters_;              ///< Scene counters of the last frame.
+
+    Font_handle font_;                               ///< Text font.
+    std::unique_ptr<sf::Text> text_;                 ///< All HUD text (one draw call).
+    sf::VertexArray vertices_;                       ///< Background and graph (one draw call).
+    sf::Clock text_clock_;                           ///< Time since the last text rebuild.
+};
@@ -8,4 +8,5 @@ struct Leaderboard_entry
 {
     std::string name;
     std::vector<int32_t> score_per_level_id;
+    int32_t total_score = 0; ///< Sum of all level scores (computed by the query).
 };
\ No newline at end of file
@@ -7,34 +7,39 @@
 #include "Scenes/Level_selection.hpp"
 #include "Scenes/Leaderboard_scene.hpp"
 #include "Leaderboard_entry.hpp"
+#include <Render/Debug_draw.hpp>
+#include <utils/profiler.hpp>
 
 
-Main_window::Main_window(const sf::Vector2u& window_size)
+Main_window::Main_window(const sf::Vector2u& window_size, const uint32_t tick_rate)
 {
+    set_tick_rate(tick_rate);
+
 	db = std::make_unique<Database>("game_database.db");
-    if (!db->is_open() || !db->execute_query(
-        "CREATE TABLE IF NOT EXISTS scores ("
-        "id INTEGER PRIMARY KEY AUTOINCREMENT, "
-        "player_name TEXT NOT NULL, "
-        "level_id INTEGER NOT NULL, "
-        "score INTEGER NOT NULL, "
-        "UNIQUE(player_name, level_id)"
-        ");"
-    ))
+    if (!db->is_open() || !init_database_schema())
     {
-        LOG_ERROR(get_global_logger(), "Failed to create scores table in database.");
+        LOG_ERROR(get_global_logger(), "Failed to create scores tables in database.");
         db.reset();
     }
+    if (db) db_worker_ = std::make_unique<Db_worker>(*db);
 
     window_ = sf::RenderWindow(sf::VideoMode(window_size), "Sky Patrol", sf::Style::Default);
     window_.setVerticalSyncEnabled(true);
 
+    // Decode shared assets in the background while the login scene is shown
+    get_resource_manager().preload_texture("assets/panel.png");
+    Game_scene::preload_assets();
+
     progress_manager_.load_from_file();
     current_level_id_ = progress_manager_.get_max_unlocked_level();
 
     current_state_ = Game_state::Login;
-    current_scene_ = std::make_unique<Login_scene>(*this);    
+    set_scene(std::make_unique<Login_scene>(*this));    
     (void)game_snapshot_.resize(window_size);
+    perf_hud_ = std::make_unique<Perf_hud>(sf::Vector2f(static_cast<float>(window_size.x) - 330.f, 10.f));
+
+    // From here on the window context belongs to the render thread
+    render_thread_ = std::make_unique<Render_thread>(window_);
 }//!Main_window
 //---------------------------------------------------------------------------------------
 
@@ -58,37 +63,162 @@ Main_window::~Main_window()
 void Main_window::run()
 {
     sf::Clock clock;
+    sf::Clock phase_clock;
+    float accumulator = 0.f;
+    FLEV_PROFILE_THREAD("main");
     while (window_.isOpen() && !should_close_)
     {
-        float dt = clock.restart().asSeconds();
-		if (dt > 0.1f) dt = 0.1f; // Spikes protection
+        FLEV_PROFILE_ZONE("frame");
+        const auto time_scale = current_scene_->get_time_scale();
+        const auto frame_time = clock.restart().asSeconds();
+        accumulator += frame_time * time_scale;
+        Frame_timing timing{ frame_time * 1000.f };
 
 		// Events
-        while (auto event = window_.pollEvent())
         {
-            if (event->getIf<sf::Event::Closed>())
+            FLEV_PROFILE_ZONE("events");
+            while (auto event = window_.pollEvent())
             {
-                close();
-                break;
+                if (event->getIf<sf::Event::Closed>())
+                {
+                    close();
+                    break;
+                }
+#if FLEV_PROFILING_ENABLED
+                if (const auto key = event->getIf<sf::Event::KeyPressed>(); key && key->code == profiler_dump_key_)
+                {
+                    (void)flev::profiler::dump_chrome_trace(profiler_trace_path_);
+                    continue;
+                }
+#endif // FLEV_PROFILING_ENABLED
+                if (const auto key = event->getIf<sf::Event::KeyPressed>(); key && handle_debug_key(key->code))
+                {
+                    continue;
+                }
+
+                // Redirect event to current scene
+                current_scene_->handle_event(event.value());
             }
+        }
 
-			// Redirect event to current scene
-            current_scene_->handle_event(event.value());
+        // Fixed-step update
+        // Fast-forward runs more ticks per frame, never a bigger dt
+        const auto max_substeps = max_substeps_ * static_cast<uint32_t>(std::ceil(std::max(time_scale, 1.f)));
+        uint32_t substeps = 0u;
+        phase_clock.restart();
+        while (accumulator >= tick_dt_ && substeps < max_substeps && !should_close_)
+        {
+            FLEV_PROFILE_ZONE("update");
+            const auto* scene = current_scene_.get();
+            current_scene_->update(tick_dt_);
+            accumulator -= tick_dt_;
+            ++substeps;
+
+            // New scene starts on the next frame
+            if (scene != current_scene_.get()) break;
         }
 
-        // Update
-        current_scene_->update(dt);
+        timing.update_ms = phase_clock.getElapsedTime().asSeconds() * 1000.f;
+
+        // Spiral of death guard: drop simulation time we could not catch up with
+        if (substeps == max_substeps) accumulator = std::min(accumulator, tick_dt_);
 
-        // Draw
-        window_.clear();
-        current_scene_->draw(window_);
-        window_.display();
+        current_scene_->set_interpolation_alpha(std::clamp(accumulator / tick_dt_, 0.f, 1.f));
+
+        // Upload textures decoded in the background
+        {
+            FLEV_PROFILE_ZONE("upload resources");
+            get_resource_manager().process_ready();
+        }
+
+        // Record the frame (drawn by the render thread while the next frame is simulated)
+        {
+            FLEV_PROFILE_ZONE("draw");
+            get_render_stats() = {};
+            phase_clock.restart();
+            auto& snapshot = render_thread_->get_back_buffer();
+            snapshot.clear();
+            get_recording_snapshot() = &snapshot;
+            current_scene_->draw(window_);
+            get_debug_draw().flush(window_); // Geometry the scene did not flush itself
+            timing.draw_ms = phase_clock.getElapsedTime().asSeconds() * 1000.f;
+
+            // HUD shows the previous frame's total (this frame is still running) and draws on top
+            if (perf_hud_->is_visible())
+            {
+                hud_counters_.clear();
+                current_scene_->get_hud_counters(hud_counters_);
+                perf_hud_->add_frame(timing, get_render_stats().draw_calls, hud_counters_);
+                perf_hud_->draw(window_);
+            }
+            get_recording_snapshot() = nullptr;
+        }
+        {
+            FLEV_PROFILE_ZONE("present");
+            render_thread_->present();
+        }
     }
+
+    // Take the context back before closing the window
+    render_thread_.reset();
+    window_.close();
 }//!run
 //---------------------------------------------------------------------------------------
 
+FLEV_NODISCARD bool Main_window::handle_debug_key(const sf::Keyboard::Key key)
+{
+    auto& debug_draw = get_debug_draw();
+    switch (key)
+    {
+    case perf_hud_key_:
+        perf_hud_->toggle();
+        return true;
+    case debug_draw_key_:
+        debug_draw.toggle();
+        return true;
+    case debug_bounds_key_:
+        debug_draw.toggle_channel(Debug_channel::Collision_bounds);
+        return true;
+    case debug_cells_key_:
+        debug_draw.toggle_channel(Debug_channel::Broadphase_cells);
+        return true;
+    case debug_spawns_key_:
+        debug_draw.toggle_channel(Debug_channel::Spawn_points);
+        return true;
+    default:
+        return false;
+    }
+}//!handle_debug_key
+//---------------------------------------------------------------------------------------
+
+void Main_window::set_tick_rate(const uint32_t tick_rate)
+{
+    tick_rate_ = std::clamp(tick_rate, 10u, 240u);
+    tick_dt_ = 1.f / static_cast<float>(tick_rate_);
+}//!set_tick_rate
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD uint32_t Main_window::get_tick_rate() const
+{
+    return tick_rate_;
+}//!get_tick_rate
+//---------------------------------------------------------------------------------------
+
+void Main_window::set_replay_options(const Replay_options& options)
+{
+    replay_options_ = options;
+}//!set_replay_options
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD const Replay_options& Main_window::get_replay_options() const
+{
+    return replay_options_;
+}//!get_replay_options
+//---------------------------------------------------------------------------------------
+
 void Main_window::switch_to(const Game_state state)
 {
+    FLEV_PROFILE_FUNCTION();
     if (current_state_ == Game_state::Login)
     {
         player_name_ = static_cast<Login_scene*>(current_scene_.get())->get_player_name();
@@ -98,19 +228,19 @@ void Main_window::switch_to(const Game_state state)
 
     if (state == Game_state::Game)
     {
-        current_scene_ = std::make_unique<Game_scene>(*this, current_level_id_);
+        set_scene(std::make_unique<Game_scene>(*this, current_level_id_));
     }
     else if (state == Game_state::Level_Selection)
     {
-        current_scene_ = std::make_unique<Level_selection_scene>(*this);
+        set_scene(std::make_unique<Level_selection_scene>(*this));
     }
     else if (state == Game_state::Game_over)
     {
-        current_scene_ = std::make_unique<Game_over_scene>(*this);
+        set_scene(std::make_unique<Game_over_scene>(*this));
     }
     else if (state == Game_state::Main_Menu)
     {
-        current_scene_ = std::make_unique<Main_menu>(*this, player_name_);
+        set_scene(std::make_unique<Main_menu>(*this, player_name_));
     }
     else if (state == Game_state::Leaderboard)
     {
@@ -129,9 +259,11 @@ void Main_window::switch_to(const Game_state state)
 
 void Main_window::switch_to_victory(const int32_t score)
 {
-    if (db)
+    FLEV_PROFILE_FUNCTION();
+    if (db_worker_)
     {
-        const auto success = db->execute_prepared(
+        // Write-behind: the commit runs on the database thread, failures are logged there
+        db_worker_->submit(
             "INSERT INTO scores (player_name, level_id, score) "
             "VALUES ({}, {}, {}) "
             "ON CONFLICT(player_name, level_id) DO UPDATE SET "
@@ -142,17 +274,8 @@ void Main_window::switch_to_victory(const int32_t score)
                 score
             }
         );
-        if (!success)
-        {
-            LOG_ERROR(
-                get_global_logger(),
-                "Failed to save score for player '{}' on level '{}'",
-                player_name_,
-                current_level_id_
-            );
-        }
     }
-    current_scene_ = std::make_unique<Victory_scene>(*this, current_level_id_, score);
+    set_scene(std::make_unique<Victory_scene>(*this, current_level_id_, score));
 }//!switch_to_victory
 //---------------------------------------------------------------------------------------
 
@@ -190,10 +313,23 @@ FLEV_NODISCARD bool Main_window::unlock_next_level()
 void Main_window::close()
 {
     should_close_ = true;
-    window_.close();
 }//!close
 //---------------------------------------------------------------------------------------
 
+void Main_window::set_scene(std::unique_ptr<Scene> scene)
+{
+    // The frame in flight may still point to textures of the old scene
+    if (render_thread_) render_thread_->wait_idle();
+
+    // Every other scene leads to a level, so its assets stay cached (or get queued) meanwhile
+    if (scene->get_scene_type() != Game_state::Game) Game_scene::preload_assets();
+    current_scene_ = std::move(scene);
+
+    // Textures and fonts only the old scene used are freed now that it is gone
+    get_resource_manager().release_unused();
+}//!set_scene
+//---------------------------------------------------------------------------------------
+
 FLEV_NODISCARD sf::RenderWindow& Main_window::get_window()
 { 
     return window_; 
@@ -218,77 +354,139 @@ FLEV_NODISCARD const sf::Texture* Main_window::get_game_snapshot() const
 }//!get_game_snapshot
 //---------------------------------------------------------------------------------------
 
+FLEV_NODISCARD Job_system& Main_window::get_job_system()
+{
+    return job_system_;
+}//!get_job_system
+//---------------------------------------------------------------------------------------
+
 FLEV_NODISCARD void Main_window::create_leaderboard_scene()
 {
+    FLEV_PROFILE_FUNCTION();
     if (!db)
     {
         LOG_ERROR(get_global_logger(), "Database not initialized, cannot switch to Leaderboard scene.");
         return;
     }
-    if (!db->execute_query("SELECT * FROM scores"))
-    {
-        LOG_ERROR(get_global_logger(), "Database selection failed, cannot switch to Leaderboard scene.");
-        return;
-    }
-    const auto cols = db->get_cols();
-    const auto name_idx = std::distance(
-        cols.begin(),
-        std::find(cols.begin(), cols.end(), "player_name")
-    );
-    const auto level_id_idx = std::distance(
-        cols.begin(),
-        std::find(cols.begin(), cols.end(), "level_id")
-    );
-    const auto score_idx = std::distance(
-        cols.begin(),
-        std::find(cols.begin(), cols.end(), "score")
-    );
-    const auto rows = db->get_rows();
+    // Scores saved on victory may still be queued
+    if (db_worker_) (void)db_worker_->flush().get();
+
+    // Totals are kept current by triggers, so ranking reads the first rows of the
+    // player_totals_rank index; only the shown players' rows arrive, ordered by rank, then level
     std::vector<Leaderboard_entry> entries;
-    for (const auto& row : rows)
-    {
-        const std::string player_name = row[name_idx];
-        const int32_t level_id = std::stoi(row[level_id_idx]);
-        const int32_t score = std::stoi(row[score_idx]);
-        auto it = std::find_if(
-            entries.begin(),
-            entries.end(),
-            [&player_name](const Leaderboard_entry& entry) {
-                return entry.name == player_name;
-            }
-        );
-        if (it != entries.end())
-        {
-            if (it->score_per_level_id.size() <= static_cast<size_t>(level_id))
+    const auto success = db->for_each_row(
+        "WITH top_players AS ("
+        "SELECT player_name, total FROM player_totals "
+        "ORDER BY total DESC, player_name LIMIT {}"
+        ") "
+        "SELECT t.player_name, t.total, s.level_id, s.score "
+        "FROM top_players AS t JOIN scores AS s ON s.player_name = t.player_name "
+        "ORDER BY t.total DESC, t.player_name, s.level_id;",
+        { leaderboard_size_ },
+        [&entries](const Database::Row_view& row) {
+            const std::string_view player_name = row.get_text(0);
+            if (entries.empty() || entries.back().name != player_name)
             {
-                it->score_per_level_id.resize(level_id + 1, 0);
+                entries.push_back({ std::string(player_name), {}, static_cast<int32_t>(row.get_int64(1)) });
             }
-            it->score_per_level_id[level_id] = score;
-        }
-        else
-        {
-            Leaderboard_entry new_entry;
-            new_entry.name = player_name;
-            if (new_entry.score_per_level_id.size() <= static_cast<size_t>(level_id))
+            auto& entry = entries.back();
+            const auto level_id = static_cast<size_t>(row.get_int64(2));
+            if (entry.score_per_level_id.size() <= level_id)
             {
-                new_entry.score_per_level_id.resize(level_id + 1, 0);
+                entry.score_per_level_id.resize(level_id + 1, 0);
             }
-            new_entry.score_per_level_id[level_id] = score;
-            entries.push_back(new_entry);
-        }
-    }
-    std::sort(
-        entries.begin(),
-        entries.end(),
-        [](const Leaderboard_entry& a, const Leaderboard_entry& b) {
-            int32_t total_a = 0;
-            for (const auto& score : a.score_per_level_id) total_a += score;
-            int32_t total_b = 0;
-            for (const auto& score : b.score_per_level_id) total_b += score;
-            return total_a > total_b;
+            entry.score_per_level_id[level_id] = static_cast<int32_t>(row.get_int64(3));
         }
     );
+    if (!success)
+    {
+        LOG_ERROR(get_global_logger(), "Database selection failed, cannot switch to Leaderboard scene.");
+        return;
+    }
+    set_scene(std::make_unique<Leaderboard_scene>(*this, entries));
+}//!create_leaderboard_scene
+//---------------------------------------------------------------------------------------
 
-    if (entries.size() > 10) entries.resize(10); // Keep only top 10 entries
-    current_scene_ = std::make_unique<Leaderboard_scene>(*this, entries);
-}//!create_leaderboard_scene
\ No newline at end of file
+FLEV_NODISCARD bool Main_window::init_database_schema()
+{
+    if (!db->execute_query(
+        "CREATE TABLE IF NOT EXISTS scores ("
+        "id INTEGER PRIMARY KEY AUTOINCREMENT, "
+        "player_name TEXT NOT NULL, "
+        "level_id INTEGER NOT NULL, "
+        "score INTEGER NOT NULL, "
+        "UNIQUE(player_name, level_id)"
+        ");"
+    ))
+    {
+        return false;
+    }
+
+    int64_t schema_version = 0;
+    if (!db->for_each_row("PRAGMA user_version;", {}, [&schema_version](const Database::Row_view& row) {
+        schema_version = row.get_int64(0);
+    }))
+    {
+        return false;
+    }
+
+    // Version 1: per-player totals maintained by triggers on scores. Created and filled from the
+    // existing scores in one transaction, so databases written by older builds are migrated once
+    if (schema_version < 1)
+    {
+        LOG_INFO(get_global_logger(), "Building player totals table for the leaderboard.");
+        if (!migrate_to_player_totals()) return false;
+    }
+
+    // Version 2: nothing sums scores per player anymore, so the index earlier builds kept for
+    // it would only slow down every score write
+    if (schema_version < 2 && !db->execute_query(
+        "DROP INDEX IF EXISTS scores_player_score;"
+        "PRAGMA user_version = 2;"
+    ))
+    {
+        return false;
+    }
+    return true;
+}//!init_database_schema
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD bool Main_window::migrate_to_player_totals()
+{
+    const bool migrated = db->execute_query(
+        "BEGIN IMMEDIATE;"
+        "CREATE TABLE IF NOT EXISTS player_totals ("
+        "player_name TEXT PRIMARY KEY, "
+        "total INTEGER NOT NULL"
+        ") WITHOUT ROWID;"
+        "CREATE INDEX IF NOT EXISTS player_totals_rank ON player_totals (total DESC, player_name);"
+        "CREATE TRIGGER IF NOT EXISTS scores_totals_insert AFTER INSERT ON scores BEGIN "
+        "INSERT INTO player_totals (player_name, total) VALUES (NEW.player_name, NEW.score) "
+        "ON CONFLICT(player_name) DO UPDATE SET total = total + excluded.total; "
+        "END;"
+        // Also fires for the DO UPDATE branch of the score upsert
+        "CREATE TRIGGER IF NOT EXISTS scores_totals_update AFTER UPDATE OF player_name, score ON scores BEGIN "
+        "UPDATE player_totals SET total = total - OLD.score WHERE player_name = OLD.player_name; "
+        "INSERT INTO player_totals (player_name, total) VALUES (NEW.player_name, NEW.score) "
+        "ON CONFLICT(player_name) DO UPDATE SET total = total + excluded.total; "
+        "DELETE FROM player_totals WHERE player_name = OLD.player_name "
+        "AND NOT EXISTS (SELECT 1 FROM scores WHERE player_name = OLD.player_name); "
+        "END;"
+        "CREATE TRIGGER IF NOT EXISTS scores_totals_delete AFTER DELETE ON scores BEGIN "
+        "UPDATE player_totals SET total = total - OLD.score WHERE player_name = OLD.player_name; "
+        "DELETE FROM player_totals WHERE player_name = OLD.player_name "
+        "AND NOT EXISTS (SELECT 1 FROM scores WHERE player_name = OLD.player_name); "
+        "END;"
+        "DELETE FROM player_totals;"
+        "INSERT INTO player_totals (player_name, total) "
+        "SELECT player_name, SUM(score) FROM scores GROUP BY player_name;"
+        "PRAGMA user_version = 1;"
+        "COMMIT;"
+    );
+    if (!migrated)
+    {
+        (void)db->execute_query("ROLLBACK;");
+        return false;
+    }
+    return true;
+}//!migrate_to_player_totals
\ No newline at end of file
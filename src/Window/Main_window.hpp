@@ -1,7 +1,12 @@
 #pragma once
 #include "Level/Progress_manager.hpp"
+#include "Level/Replay.hpp"
 #include "Scenes/Scene.hpp"
+#include <UI/Perf_hud.hpp>
+#include <Render/Render_thread.hpp>
 #include <utils/database_api.hpp>
+#include <utils/db_worker.hpp>
+#include <utils/job_system.hpp>
 #include <utils/defines.hpp>
 #include <memory>
 #include <map>
@@ -11,15 +16,43 @@ class Main_window
 {
 public:
 
-    /** @brief Constructs the window with optional size [Default: 1920x1080]. */
-    Main_window(const sf::Vector2u& window_size = { 1920u, 1080u });
+    /**
+     * @brief Constructs the window.
+     *
+     * @param window_size[in][opt] - Window size. [Default: 1920x1080]
+     * @param tick_rate[in][opt]   - Simulation ticks per second. [Default: 60]
+     */
+    Main_window(const sf::Vector2u& window_size = { 1920u, 1080u }, const uint32_t tick_rate = 60u);
 
     /** @brief Saves progress on destruction. */
     ~Main_window() noexcept;
 
-    /** @brief Main game loop: event handling, update, draw. */
+    /**
+     * @brief Main game loop: event handling, fixed-step update, interpolated draw.
+     *
+     * Scenes are updated with a constant dt of 1 / tick rate. Frame time is
+     * accumulated and consumed in whole ticks (at most max_substeps_ per frame);
+     * the remainder is passed to the scene as interpolation factor. The scene
+     * is recorded into a frame snapshot that the render thread draws and
+     * presents while the next frame is simulated.
+     * F3 toggles the performance HUD, F4 the debug geometry layer and F5-F7
+     * its channels (collision bounds, broadphase cells, spawn points). With
+     * profiling enabled, F10 writes recorded zones to profile_trace.json.
+     */
     void run();
 
+    /** @brief Sets simulation tick rate (ticks per second, clamped to [10, 240]). */
+    void set_tick_rate(const uint32_t tick_rate);
+
+    /** @returns Simulation tick rate (ticks per second). */
+    FLEV_NODISCARD uint32_t get_tick_rate() const;
+
+    /** @brief Sets replay files used by game scenes (recording and/or playback). */
+    void set_replay_options(const Replay_options& options);
+
+    /** @returns Replay files used by game scenes. */
+    FLEV_NODISCARD const Replay_options& get_replay_options() const;
+
     /** @brief Switches to a named game state (creates corresponding scene). */
     void switch_to(const Game_state state);
 
@@ -41,7 +74,7 @@ public:
     /** @brief Unlocks the next level (current_level_id_ + 1). */
     FLEV_NODISCARD bool unlock_next_level();
 
-    /** @brief Requests application shutdown. */
+    /** @brief Requests application shutdown (the window closes when run() returns). */
     void close();
 
     /** @brief Returns reference to SFML render window. */
@@ -56,8 +89,37 @@ public:
     /** @brief Returns last game frame texture (for GameOverScene). */
     FLEV_NODISCARD const sf::Texture* get_game_snapshot() const;
 
+    /** @brief Returns the worker pool shared by game scenes (parallel entity update). */
+    FLEV_NODISCARD Job_system& get_job_system();
+
 private/*methods*/:
 
+    /** @brief Handles performance HUD and debug draw hotkeys. Returns true if the key was consumed. */
+    FLEV_NODISCARD bool handle_debug_key(const sf::Keyboard::Key key);
+
+    /** @brief Replaces the current scene once the render thread no longer draws it. */
+    void set_scene(std::unique_ptr<Scene> scene);
+
+    /**
+     * @brief Creates score tables, indices and leaderboard triggers.
+     *
+     * Older databases are migrated once, step by step (PRAGMA user_version):
+     * version 1 adds trigger-maintained player totals, version 2 drops the
+     * per-player sum index they replaced.
+     *
+     * @returns false if the schema could not be created or migrated.
+     */
+    FLEV_NODISCARD bool init_database_schema();
+
+    /**
+     * @brief Creates player_totals with its index and triggers and fills it from existing scores.
+     *
+     * Runs in one transaction and sets the schema version to 1.
+     *
+     * @returns false if the migration failed (it is rolled back).
+     */
+    FLEV_NODISCARD bool migrate_to_player_totals();
+
     /** @brief Loads leaderboard data from DB and creates Leaderboard_scene. */
     FLEV_NODISCARD void create_leaderboard_scene();
 
@@ -69,6 +131,18 @@ private/*vars*/:
     sf::RenderWindow window_;     ///< SFML application window.
     bool should_close_ = false;   ///< Shutdown flag.
 
+    // -----------------------------------------------------------------------
+    // Simulation timing
+    // -----------------------------------------------------------------------
+    uint32_t tick_rate_ = 60u;            ///< Simulation ticks per second.
+    float tick_dt_ = 1.f / 60.f;          ///< Fixed simulation step (seconds).
+    static constexpr uint32_t max_substeps_ = 8u; ///< Max ticks per frame (spiral of death guard).
+
+    // -----------------------------------------------------------------------
+    // Threading
+    // -----------------------------------------------------------------------
+    Job_system job_system_;                ///< Workers for parallel entity update (one per extra core).
+
     // -----------------------------------------------------------------------
     // Game state
     // -----------------------------------------------------------------------
@@ -76,15 +150,36 @@ private/*vars*/:
     Game_state current_state_;             ///< Current game state enum.
     std::string player_name_;              ///< Player name (set after login).
     int32_t current_level_id_ = 0;         ///< Level ID for next Game_scene.
+    Replay_options replay_options_;        ///< Replay recording/playback files.
 
     // -----------------------------------------------------------------------
     // Persistence
     // -----------------------------------------------------------------------
     std::unique_ptr<Database> db;           ///< SQLite database connection.
+    std::unique_ptr<Db_worker> db_worker_;  ///< Runs score writes off the main thread (declared after db, drained first).
+    static constexpr int32_t leaderboard_size_ = 10; ///< Players shown in the leaderboard.
     Progress_manager progress_manager_;     ///< Tracks unlocked levels (file-based).
 
     // -----------------------------------------------------------------------
     // Rendering
     // -----------------------------------------------------------------------
     sf::RenderTexture game_snapshot_;       ///< Last game frame.
+    std::unique_ptr<Perf_hud> perf_hud_;    ///< Performance overlay (hidden by default).
+    std::vector<Hud_counter> hud_counters_; ///< Scene counters of the current frame (reused).
+    std::unique_ptr<Render_thread> render_thread_; ///< Draws recorded frames (destroyed before scenes).
+
+    // -----------------------------------------------------------------------
+    // Debug hotkeys
+    // -----------------------------------------------------------------------
+    static constexpr sf::Keyboard::Key perf_hud_key_ = sf::Keyboard::Key::F3;     ///< Toggles the performance HUD.
+    static constexpr sf::Keyboard::Key debug_draw_key_ = sf::Keyboard::Key::F4;   ///< Toggles the debug geometry layer.
+    static constexpr sf::Keyboard::Key debug_bounds_key_ = sf::Keyboard::Key::F5; ///< Toggles collision bounds.
+    static constexpr sf::Keyboard::Key debug_cells_key_ = sf::Keyboard::Key::F6;  ///< Toggles broadphase cells.
+    static constexpr sf::Keyboard::Key debug_spawns_key_ = sf::Keyboard::Key::F7; ///< Toggles spawn points.
+
+    // -----------------------------------------------------------------------
+    // Profiling
+    // -----------------------------------------------------------------------
+    static constexpr sf::Keyboard::Key profiler_dump_key_ = sf::Keyboard::Key::F10; ///< Dumps the profiler trace.
+    static constexpr const char* profiler_trace_path_ = "profile_trace.json";       ///< Chrome trace output file.
 };
\ No newline at end of file
@@ -21,35 +21,32 @@ Game_over_scene::Game_over_scene(Main_window& window) : Scene(window)
     });
 
 	// Font
-    if (!font_.openFromFile("assets/timesnewromanpsmt.ttf"))
-    {
-		LOG_ERROR(get_global_logger(), "Failed to load font for game over scene.");
-    }
+    font_ = get_resource_manager().get_font("assets/timesnewromanpsmt.ttf");
 
 	// Title label
-    title_label_ = std::make_unique<Label>("Вы проиграли!", font_, 38);
+    title_label_ = std::make_unique<Label>("Вы проиграли!", *font_, 38);
     title_label_->set_color(sf::Color::White);
 
 	// Buttons
 	const auto button_size = sf::Vector2f{ 200.f, 50.f };
-    buttons_.emplace("restart", std::make_unique<Button>(
+    buttons_[Action::Restart] = std::make_unique<Button>(
         sf::FloatRect({ 0, 0 }, button_size),
         "Начать заново",
-        font_,
+        *font_,
         30u
-    ));
-    buttons_.emplace("menu", std::make_unique<Button>(
+    );
+    buttons_[Action::Menu] = std::make_unique<Button>(
         sf::FloatRect({ 0, 0 }, button_size),
         "В меню",
-        font_,
+        *font_,
         30u
-    ));
-    buttons_.emplace("exit", std::make_unique<Button>(
+    );
+    buttons_[Action::Exit] = std::make_unique<Button>(
         sf::FloatRect({ 0, 0 }, button_size),
         "Выйти",
-        font_,
+        *font_,
         30u
-    ));
+    );
 
     // Positioning objects on the panel
     const auto panel_pos = panel_->get_bounds().position;
@@ -61,29 +58,31 @@ Game_over_scene::Game_over_scene(Main_window& window) : Scene(window)
         panel_pos.y + 10.f
     });
 
-    buttons_["restart"]->set_position({ panel_center.x - 100.f, panel_pos.y + 80.f });
-    buttons_["menu"]->set_position({ panel_center.x - 100.f, panel_pos.y + 150.f });
-    buttons_["exit"]->set_position({ panel_center.x - 100.f, panel_pos.y + 220.f });
+    buttons_[Action::Restart]->set_position({ panel_center.x - 100.f, panel_pos.y + 80.f });
+    buttons_[Action::Menu]->set_position({ panel_center.x - 100.f, panel_pos.y + 150.f });
+    buttons_[Action::Exit]->set_position({ panel_center.x - 100.f, panel_pos.y + 220.f });
 }//!Game_over_scene
 //---------------------------------------------------------------------------------------
 
 void Game_over_scene::handle_event(const sf::Event& event)
 {
-    for (auto& [name, btn] : buttons_)
+    for (const auto action : enum_values<Action>())
     {
-        if (btn->handle_event(event))
+        if (buttons_[action]->handle_event(event))
         {
-            if (name == "restart")
+            switch (action)
             {
+            case Action::Restart:
                 main_window_.switch_to(Game_state::Game);
-            }
-            else if (name == "menu")
-            {
+                break;
+            case Action::Menu:
                 main_window_.switch_to(Game_state::Main_Menu);
-            }
-            else if (name == "exit")
-            {
+                break;
+            case Action::Exit:
                 main_window_.close();
+                break;
+            default:
+                break;
             }
             break;
         }
@@ -106,16 +105,16 @@ void Game_over_scene::draw(sf::RenderTarget& render_target)
     if (const auto* snapshot = main_window_.get_game_snapshot())
     {
         sf::Sprite sprite(*snapshot);
-        render_target.draw(sprite);
+        draw_counted(render_target, sprite);
     }
 
     // Shading
-    render_target.draw(overlay_);
+    draw_counted(render_target, overlay_);
 
 	// Panel and buttons
     panel_->draw(render_target);
     title_label_->draw(render_target);
-    for (const auto& [_, btn] : buttons_)
+    for (const auto& btn : buttons_)
     {
         btn->draw(render_target);
     }
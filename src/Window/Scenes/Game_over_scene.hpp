@@ -3,7 +3,7 @@
 #include <UI/Panel.hpp>
 #include <UI/Label.hpp>
 #include <UI/Button.hpp>
-#include <map>
+#include <utils/enum_array.hpp>
 #include <memory>
 
 class Game_over_scene final : public Scene
@@ -25,12 +25,24 @@ public:
     /** @brief Returns Game_state::Game_over. */
     FLEV_NODISCARD Game_state get_scene_type() const override;
 
-private:
+private/*types*/:
 
-    sf::Font font_;                                          ///< Font for all text elements.
+    /** @brief Navigation button actions. */
+    enum class Action : uint8_t
+    {
+        Restart,
+        Menu,
+        Exit,
+
+        Count
+    };
+
+private/*vars*/:
+
+    Font_handle font_;                                       ///< Font for all text elements.
 
     sf::RectangleShape overlay_;                             ///< Semi-transparent dimming layer over game snapshot
     std::unique_ptr<Panel> panel_;                           ///< Central UI panel.
     std::unique_ptr<Label> title_label_;                     ///< Static header.
-    std::map<std::string, std::unique_ptr<Button>> buttons_; ///< Navigation buttons by action name..
+    Enum_array<Action, std::unique_ptr<Button>> buttons_;    ///< Navigation buttons by action.
 };
\ No newline at end of file
@@ -1,61 +1,104 @@
 #include "Game_scene.hpp"
 #include "../Main_window.hpp"
 
-#include "Entities/Small_stone.hpp"
-#include "Entities/Big_stone.hpp"
-#include "Entities/Scout.hpp"
-#include "Entities/Warrior.hpp"
+#include "Entities/Enemy_archetypes.hpp"
 
-#include <utils/debug_bounds.hpp>
+#include <UI/Perf_hud.hpp>
+#include <Render/Debug_draw.hpp>
+#include <utils/profiler.hpp>
 #include <random>
+#include <algorithm>
+#include <format>
+#include <iterator>
+#include <memory_resource>
+#include <string>
 
 Game_scene::Game_scene(Main_window& window, const int32_t level_id): 
-    Scene(window), current_level_id_(level_id)
+    Scene(window)
+    , scratch_(scratch_capacity_, level_arena_.get_resource())
+    , playback_(load_playback(window, level_id))
+    , world_(level_id, window.get_window_size(), playback_ ? playback_->seed : std::random_device{}(), level_arena_.get_resource())
 {
-    switch (current_level_id_)
-    {
-    case 0:
-        level_duration_ = 120.f;
-        spawn_time_ = 1.5f; 
-		break;
+    FLEV_PROFILE_ZONE("Game_scene::Game_scene");
 
-    default:
-        level_duration_ = 0.f;
-        spawn_time_ = 3.f;
-		break;
+    // Replays
+    if (playback_) replay_player_.emplace(*playback_);
+    if (!window.get_replay_options().record_path.empty())
+    {
+        recording_.emplace();
+        recording_->level_id = level_id;
+        recording_->seed = world_.get_seed();
+        recording_->tick_rate = window.get_tick_rate();
+        recording_->world_size = world_.get_world_size();
     }
 
-    // Player
     auto window_size = window.get_window_size();
-    player_.set_position(sf::Vector2f(window_size.x / 6.f, window_size.y / 2.f));
+
+    // Entities
+    world_.set_job_system(&window.get_job_system());
+    initialize_entities();
 
 	// UI
     initialize_sky(window_size);
     initialize_ui(window_size);
     initialize_pause_menu(window_size);
-
-    // Level begins
-    level_timer_.restart();
 }//!Game_scene
 //---------------------------------------------------------------------------------------
 
+Game_scene::~Game_scene()
+{
+    // Recorded run
+    const auto& record_path = main_window_.get_replay_options().record_path;
+    if (recording_ && !recording_->inputs.empty() && recording_->save(record_path))
+    {
+        LOG_INFO(get_global_logger(), "Replay of {} ticks saved to {}.", recording_->inputs.size(), record_path);
+    }
+
+    // Pool statistics for capacity tuning
+    const auto& bullets = world_.get_bullets();
+    const auto& enemy_bullets = world_.get_enemy_bullets();
+    LOG_INFO(
+        get_global_logger(),
+        "Bullet pools on level {}: player {}/{} peak ({} dropped), enemy {}/{} peak ({} dropped).",
+        world_.get_level_id(),
+        bullets.get_high_water_mark(), bullets.capacity(), bullets.get_dropped_count(),
+        enemy_bullets.get_high_water_mark(), enemy_bullets.capacity(), enemy_bullets.get_dropped_count()
+    );
+
+    // Mean simulation phase cost
+    const auto& stats = world_.get_stats();
+    if (stats.ticks > 0)
+    {
+        const auto per_tick_us = 1e6 / static_cast<double>(stats.ticks);
+        LOG_INFO(
+            get_global_logger(),
+            "Simulation on level {}: {} ticks, spawn {:.2f} us, movement {:.2f} us, collisions {:.2f} us per tick.",
+            world_.get_level_id(), stats.ticks,
+            stats.spawn_time * per_tick_us, stats.movement_time * per_tick_us, stats.collision_time * per_tick_us
+        );
+    }
+}//!~Game_scene
+//---------------------------------------------------------------------------------------
+
 void Game_scene::handle_event(const sf::Event& event)
 {
-    for (auto& [name, btn] : pause_buttons_)
+    for (const auto action : enum_values<Pause_action>())
     {
-        if (btn->handle_event(event))
+        if (pause_buttons_[action]->handle_event(event))
         {
-            if (name == "resume")
-            {
-                paused_ = !paused_;
-            }
-            else if (name == "menu")
+            switch (action)
             {
+            case Pause_action::Resume:
+                toggle_pause();
+                break;
+            case Pause_action::Menu:
                 main_window_.switch_to(Game_state::Main_Menu);
-            }
-            else if (name == "exit")
-            {
+                break;
+            case Pause_action::Exit:
                 main_window_.close();
+                break;
+            default:
+                break;
             }
             break;
         }
@@ -65,360 +108,423 @@ void Game_scene::handle_event(const sf::Event& event)
     {
         if (key->code == sf::Keyboard::Key::Escape)
         {
-            paused_ = !paused_;
+            toggle_pause();
             return;
         }
+        if (key->code == sf::Keyboard::Key::Tab)
+        {
+            world_.get_sim_clock().set_time_scale(fast_forward_scale_);
+        }
+    }
+    else if (auto key = event.getIf<sf::Event::KeyReleased>())
+    {
+        if (key->code == sf::Keyboard::Key::Tab)
+        {
+            world_.get_sim_clock().set_time_scale(1.f);
+        }
     }
 }//!handle_event
 //---------------------------------------------------------------------------------------
 
 void Game_scene::update(const float dt)
 {
-    if (paused_) return;
-    const auto window_size = main_window_.get_window_size();
+    FLEV_PROFILE_FUNCTION();
+    scratch_.reset();
+
+    // Previous state for render interpolation (also freezes interpolation while paused)
+    save_previous_state();
+
+    const auto tick = world_.get_sim_clock().get_tick();
+    Player_input input;
+    {
+        FLEV_PROFILE_ZONE("input");
+        input = replay_player_ ? replay_player_->get_input() : poll_player_input();
+    }
+    const auto status = world_.update(dt, input);
+    if (world_.get_sim_clock().get_tick() != tick)
+    {
+        FLEV_PROFILE_ZONE("replay");
+        track_replay(input);
+    }
+    if (world_.get_sim_clock().is_paused()) return;
 
-    // Game over
-    if (!player_.is_alive())
+    sync_health_icons();
+    switch (status)
     {
+    case World_status::Defeat:
+    {
+        FLEV_PROFILE_ZONE("game over snapshot");
+
 		// Render screenshot for game over scene
         auto& target = main_window_.get_snapshot_target();
-        if (!target.resize(window_size))
+        if (!target.resize(main_window_.get_window_size()))
         {
 			LOG_ERROR(get_global_logger(), "Failed to resize render texture for game over screenshot.");
         }
         target.clear();
-        for (const auto& sky : sky_sprites_) { target.draw(*sky); }
+        for (const auto& sky : sky_sprites_) { draw_counted(target, *sky); }
         win_cond_label_.draw(target);
-        draw_game_objects(target);
+        draw_game_objects(target, 1.f);
         target.display();
 
 		// Switch to game over scene
         main_window_.switch_to(Game_state::Game_over);
         return;
     }
+    case World_status::Victory:
+        main_window_.switch_to_victory(world_.get_score());
+        return;
 
-    // Enemies spawn
-    if (spawn_clock_.getElapsedTime().asSeconds() > spawn_time_)
-    {
-        spawn_enemy();
-        spawn_clock_.restart();
-    }
-
-	// Bullets spawn
-    if (player_.is_need_to_shoot())
-    {
-        const auto pb = player_.get_bounds();
-        bullets_.push_back(std::make_unique<Bullet>(
-            sf::Vector2f(pb.position.x + pb.size.x, pb.position.y + pb.size.y / 2.f),
-            sf::Vector2f(800.f, 0.f)
-        ));
+    case World_status::Running:
+        break;
     }
 
     // Background update
+    FLEV_PROFILE_ZONE("ui");
     update_sky(dt);
-    
-    // Timer update
-    if (level_duration_ > 0)
-    {
-        const auto remaining = static_cast<int32_t>(level_duration_ - level_timer_.getElapsedTime().asSeconds());
-        if (remaining <= 0)
-        {
-            // Victory
-            score_ += player_.get_hp() * 10; // Bonus for remaining health
-            main_window_.switch_to_victory(score_);
-            return;
-        }
-        win_cond_label_.set_text(std::format("До станции осталось: {} миль.", std::max(0, remaining / 2)));
-    }
-    // Level 1 win condition
-    if (current_level_id_ == 1)
-    {
-        const auto total_enemies = total_scout_enemies_ + total_warrior_enemies_;
-        win_cond_label_.set_text(std::format("Противников осталось: {}", total_enemies));
-        if (total_enemies <= 0)
-        {
-            // Victory
-			score_ += (200 - level_timer_.getElapsedTime().asSeconds()) * 3; // Bonus for speed
-            score_ += player_.get_hp() * 10; // Bonus for remaining health
-            main_window_.switch_to_victory(score_);
-            return;
-        }
-    }
+    update_win_cond_label();
+}//!update
+//---------------------------------------------------------------------------------------
+
+void Game_scene::draw(sf::RenderTarget& render_target)
+{
+    scratch_.reset();
 
-	// Player update
-    player_.update(dt, window_size);
+    // UI
+    draw_sky(render_target);
+    draw_counted(render_target, *controls_);
+    for (const auto& icon : health_icons_) { draw_counted(render_target, *icon); }
+    win_cond_label_.draw(render_target);
 
+    // Game objects
+    draw_game_objects(render_target, render_alpha_);
 
-	// Bullets update
-    for (auto it = bullets_.begin(); it != bullets_.end(); )
+	//Pause overlay
+    if (world_.get_sim_clock().is_paused())
     {
-        (*it)->update(dt);
-        if ((*it)->is_out_of_bounds(window_size))
-        {
-            it = bullets_.erase(it);
-        }
-        else
-        {
-            ++it;
-        }
+        draw_counted(render_target, pause_overlay_);
+        pause_panel_->draw(render_target);
+        for (auto& btn : pause_buttons_) btn->draw(render_target);
     }
+}//!draw
+//---------------------------------------------------------------------------------------
 
-    // Enemy bullets update
-    for (auto it = enemy_bullets_.begin(); it != enemy_bullets_.end(); )
-    {
-        (*it)->update(dt);
-        if ((*it)->is_out_of_bounds(window_size))
+void Game_scene::draw_game_objects(sf::RenderTarget& render_target, const float alpha)
+{
+    FLEV_PROFILE_FUNCTION();
+
+    for (auto& batch : entity_batches_) batch.clear();
+    auto& player_layer = entity_batches_[layer_index(Entity_layer::Player)];
+    auto& enemy_layer = entity_batches_[layer_index(Entity_layer::Enemies)];
+    auto& enemy_bullet_layer = entity_batches_[layer_index(Entity_layer::Enemy_bullets)];
+
+    auto& debug_draw = get_debug_draw();
+    const auto bounds_color = sf::Color::Red;
+
+    const auto& player = world_.get_player();
+    player_layer.add(player_region_, player.get_interpolated_position(alpha), Player::scale);
+    debug_draw.add_box(Debug_channel::Collision_bounds, player.get_bounds(), bounds_color);
+
+    const auto add_bullets = [&debug_draw, bounds_color, alpha](
+        Sprite_batch& batch,
+        const Bullet_pool& bullets,
+        const sf::IntRect& region,
+        const sf::Vector2f& scale
+    ) {
+        for (size_t i = 0; i < bullets.size(); ++i)
         {
-            it = enemy_bullets_.erase(it);
+            batch.add(region, bullets.get_interpolated_position(i, alpha), scale);
+            debug_draw.add_box(Debug_channel::Collision_bounds, bullets.bounds()[i], bounds_color);
         }
-        else
+    };
+    const auto add_enemies = [&](const Enemy_type type, const sf::Vector2f& scale) {
+        const auto& enemies = world_.get_enemies(type);
+        const auto& region = enemy_regions_[to_index(type)];
+        for (size_t i = 0; i < enemies.size(); ++i)
         {
-            ++it;
+            enemy_layer.add(region, enemies.get_interpolated_position(i, alpha), scale, enemies.rotations[i]);
+            debug_draw.add_box(Debug_channel::Collision_bounds, enemies.bounds[i], bounds_color);
         }
-    }
+    };
 
-	// Enemies update
-    for (auto& [type, enemies] : enemies_)
-    {
-        for (auto it = enemies.begin(); it != enemies.end(); )
-        {
-            (*it)->update(dt, window_size);
+    add_bullets(player_layer, world_.get_bullets(), bullet_region_, Bullet::scale);
 
-            // Enemy shooting
-            if (type == "warrior")
-            {
-                Warrior* warrior_enemy = dynamic_cast<Warrior*>(it->get());
-                if (warrior_enemy->is_need_to_shoot())
-                {
-                    const auto enemy_bounds = warrior_enemy->get_bounds();
-                    enemy_bullets_.push_back(std::make_unique<Bullet>(
-                        sf::Vector2f(enemy_bounds.position.x, enemy_bounds.position.y + enemy_bounds.size.y / 2.f),
-                        sf::Vector2f(-600.f, 0.f),
-                        "assets/enemy_bullet1.png"
-                    ));
-                }
-            }
+	// 1st level enemies
+    add_enemies(Enemy_type::Big_stone, Big_stone::scale);
+    add_enemies(Enemy_type::Small_stone, Small_stone::scale);
 
-            if ((*it)->is_out_of_bounds(window_size))
-            {
-                it = enemies.erase(it);
-            }
-            else
-            {
-				// Collision with player
-                if ((*it)->get_bounds().findIntersection(player_.get_bounds()))
-                {
-                    const auto old_hp = player_.get_hp();
-                    const auto is_player_dead = player_.take_damage(1);
-                    const auto new_hp = player_.get_hp();
-                    if (new_hp < old_hp && new_hp >= 0)
-                    {
-                        health_icons_[new_hp]->setTexture(ui_textures_["heart_empty"]);
-                    }
-
-                    if (type == "scout") total_scout_enemies_--;
-					else if (type == "warrior") total_warrior_enemies_--;
-
-                    if (is_player_dead)
-                    {
-                        // Do not erase enemy if player is dead (for game over screen)
-                        it++;
-                    }
-                    else
-                    {
-                        it = enemies.erase(it);
-                    }
-                }
-                else
-                {
-                    it++;
-                }
-            }
-        }
-    }
+    // 2nd level enemies
+    add_enemies(Enemy_type::Warrior, Warrior::scale);
+    add_enemies(Enemy_type::Scout, Scout::scale);
 
-	// Bullet-bullet collisions (player vs enemy)
-    for (auto bullet_it = bullets_.begin(); bullet_it != bullets_.end(); )
-    {
-        bool hit = false;
-        for (auto enemy_bullet_it = enemy_bullets_.begin(); enemy_bullet_it != enemy_bullets_.end(); )
-        {
-            if ((*bullet_it)->get_bounds().findIntersection((*enemy_bullet_it)->get_bounds()))
-            {
-                enemy_bullet_it = enemy_bullets_.erase(enemy_bullet_it);
-                hit = true;
-                break;
-            }
-            else
-            {
-                ++enemy_bullet_it;
-            }
-        }
-        if (hit)
-        {
-            bullet_it = bullets_.erase(bullet_it);
-        }
-        else
-        {
-            ++bullet_it;
-        }
-	}
+	// Enemy bullets
+    add_bullets(enemy_bullet_layer, world_.get_enemy_bullets(), enemy_bullet_region_, Enemy_bullet::scale);
+
+    // One draw call per layer
+    for (const auto& batch : entity_batches_) batch.draw(render_target);
+
+    // Debug geometry on top of the entities, one more draw call
+    add_debug_geometry(debug_draw);
+    debug_draw.flush(render_target);
+}//!draw_game_objects
+//---------------------------------------------------------------------------------------
 
-	// Bullet-enemy collisions
-    for (auto bullet_it = bullets_.begin(); bullet_it != bullets_.end(); )
+void Game_scene::add_debug_geometry(Debug_draw& debug_draw)
+{
+    if (debug_draw.is_active(Debug_channel::Broadphase_cells))
     {
-        bool hit = false;
-        for (auto& [type, enemies] : enemies_)
-        {
-            for (auto enemy_it = enemies.begin(); enemy_it != enemies.end(); )
-            {
-                if ((*bullet_it)->get_bounds().findIntersection((*enemy_it)->get_bounds()))
-                {
-                    if ((*enemy_it)->take_damage(1))  // Enemy destroyed
-                    {
-						score_ += (*enemy_it)->get_score_value();
-						enemy_it = enemies.erase(enemy_it);
-
-                        if (type == "scout") total_scout_enemies_--;
-                        else if (type == "warrior") total_warrior_enemies_--;
-                    }
-                    else
-                    {
-                        ++enemy_it;
-                    }
-                    hit = true;
-                    break;
-                }
-                else
-                {
-                    ++enemy_it;
-                }
-            }
-        }
-        if (hit)
+        std::pmr::vector<sf::FloatRect> cells(scratch_.get_resource());
+        world_.get_enemy_grid().get_occupied_cells(cells);
+        for (const auto& cell : cells)
         {
-            bullet_it = bullets_.erase(bullet_it);
+            debug_draw.add_box(Debug_channel::Broadphase_cells, cell, sf::Color(0, 200, 255, 120));
         }
-        else
+        world_.get_enemy_bullet_grid().get_occupied_cells(cells);
+        for (const auto& cell : cells)
         {
-            ++bullet_it;
+            debug_draw.add_box(Debug_channel::Broadphase_cells, cell, sf::Color(255, 0, 255, 120));
         }
     }
 
-	// Bullet-player collisions (enemy bullets)
-	for (auto enemy_bullet_it = enemy_bullets_.begin(); enemy_bullet_it != enemy_bullets_.end(); )
+    // Enemies spawn off-screen: mark the nearest visible point and draw a line towards the real one
+    if (debug_draw.is_active(Debug_channel::Spawn_points))
     {
-        if ((*enemy_bullet_it)->get_bounds().findIntersection(player_.get_bounds()))
+        const sf::Vector2f world_size(world_.get_world_size());
+        constexpr float margin = 12.f;
+        for (const auto& spawn : world_.get_last_spawns())
         {
-            const auto old_hp = player_.get_hp();
-            const auto is_player_dead = player_.take_damage(1);
-            const auto new_hp = player_.get_hp();
-            if (new_hp < old_hp && new_hp >= 0)
-            {
-                health_icons_[new_hp]->setTexture(ui_textures_["heart_empty"]);
-            }
-            if (is_player_dead)
-            {
-                // Do not continue checking if player is dead
-                break;
-            }
-            else
-            {
-                enemy_bullet_it = enemy_bullets_.erase(enemy_bullet_it);
-            }
+            const sf::Vector2f visible(
+                std::clamp(spawn.x, margin, world_size.x - margin),
+                std::clamp(spawn.y, margin, world_size.y - margin)
+            );
+            debug_draw.add_cross(Debug_channel::Spawn_points, visible, margin, sf::Color::Yellow);
+            debug_draw.add_line(Debug_channel::Spawn_points, visible, spawn, sf::Color::Yellow);
         }
-        else
-        {
-            ++enemy_bullet_it;
-        }
-	}
+    }
+}//!add_debug_geometry
+//---------------------------------------------------------------------------------------
 
-}//!update
+FLEV_NODISCARD float Game_scene::get_time_scale() const
+{
+    return world_.get_sim_clock().get_time_scale();
+}//!get_time_scale
 //---------------------------------------------------------------------------------------
 
-void Game_scene::draw(sf::RenderTarget& render_target)
+void Game_scene::toggle_pause()
 {
-    // UI
-    for (const auto& sky : sky_sprites_) { render_target.draw(*sky); }
-    render_target.draw(*controls_);
-    for (const auto& icon : health_icons_) { render_target.draw(*icon); }
-    win_cond_label_.draw(render_target);
+    auto& sim_clock = world_.get_sim_clock();
+    if (sim_clock.is_paused()) sim_clock.resume();
+    else sim_clock.pause();
+}//!toggle_pause
+//---------------------------------------------------------------------------------------
 
-    // Game objects
-    draw_game_objects(render_target);
+void Game_scene::set_interpolation_alpha(const float alpha)
+{
+    render_alpha_ = alpha;
+}//!set_interpolation_alpha
+//---------------------------------------------------------------------------------------
 
-	//Pause overlay
-    if (paused_)
+void Game_scene::get_hud_counters(std::vector<Hud_counter>& counters) const
+{
+    static constexpr std::array<const char*, enemy_type_count> enemy_names = {
+        "big stones", "small stones", "scouts", "warriors"
+    };
+
+    counters.push_back({ "bullets", world_.get_bullets().size() });
+    counters.push_back({ "enemy bullets", world_.get_enemy_bullets().size() });
+    for (size_t type_id = 0; type_id < enemy_type_count; ++type_id)
     {
-        render_target.draw(pause_overlay_);
-        pause_panel_->draw(render_target);
-        for (auto& [_, btn] : pause_buttons_) btn->draw(render_target);
+        counters.push_back({ enemy_names[type_id], world_.get_enemies(static_cast<Enemy_type>(type_id)).size() });
     }
-}//!draw
+}//!get_hud_counters
 //---------------------------------------------------------------------------------------
 
-void Game_scene::draw_game_objects(sf::RenderTarget& render_target)
+FLEV_NODISCARD Game_state Game_scene::get_scene_type() const
+{ 
+    return Game_state::Game; 
+}//!get_scene_type
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD Player_input Game_scene::poll_player_input()
 {
-    player_.draw(render_target);
-    flev::debug::draw_debug_bounds(render_target, player_.get_bounds());
-    for (const auto& bullet : bullets_)
-    {
-        bullet->draw(render_target);
-        flev::debug::draw_debug_bounds(render_target, bullet->get_bounds());
-    }
-    
-	// 1st level enemies
-    for (const auto& enemy : enemies_["big_stone"])
+    using Key = sf::Keyboard::Key;
+    const auto is_pressed = [](const Key key, const Key alt_key) {
+        return sf::Keyboard::isKeyPressed(key) || sf::Keyboard::isKeyPressed(alt_key);
+    };
+
+    // Arrow keys or WASD
+    Player_input input;
+    input.up = is_pressed(Key::W, Key::Up);
+    input.down = is_pressed(Key::S, Key::Down);
+    input.left = is_pressed(Key::A, Key::Left);
+    input.right = is_pressed(Key::D, Key::Right);
+    input.shoot = sf::Keyboard::isKeyPressed(Key::Space);
+    return input;
+}//!poll_player_input
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD std::optional<Replay> Game_scene::load_playback(const Main_window& window, const int32_t level_id)
+{
+    const auto& playback_path = window.get_replay_options().playback_path;
+    if (playback_path.empty()) return std::nullopt;
+
+    Replay replay;
+    if (!replay.load(playback_path)) return std::nullopt;
+    if (replay.level_id != level_id || replay.inputs.empty())
+    {
+        LOG_WARNING(
+            get_global_logger(),
+            "Replay {} is for level {} ({} ticks), level {} is played from the keyboard.",
+            playback_path, replay.level_id, replay.inputs.size(), level_id
+        );
+        return std::nullopt;
+    }
+    if (replay.tick_rate != window.get_tick_rate() || replay.world_size != window.get_window_size())
+    {
+        LOG_WARNING(
+            get_global_logger(),
+            "Replay {} was recorded at {} Hz in {}x{}, playback will diverge.",
+            playback_path, replay.tick_rate, replay.world_size.x, replay.world_size.y
+        );
+    }
+    LOG_INFO(get_global_logger(), "Playing replay {} ({} ticks, seed {}).", playback_path, replay.inputs.size(), replay.seed);
+    return replay;
+}//!load_playback
+//---------------------------------------------------------------------------------------
+
+void Game_scene::track_replay(const Player_input& input)
+{
+    if (!recording_ && !replay_player_) return;
+
+    const auto state_hash = world_.compute_state_hash();
+    if (recording_) recording_->record(input, state_hash);
+    if (!replay_player_) return;
+
+    const auto was_in_sync = replay_player_->get_divergence_tick() < 0;
+    if (!replay_player_->advance(state_hash) && was_in_sync)
     {
-        enemy->draw(render_target);
-        flev::debug::draw_debug_bounds(render_target, enemy->get_bounds());
+        LOG_WARNING(get_global_logger(), "Replay diverged from the recording at tick {}.", replay_player_->get_divergence_tick());
     }
-    for (const auto& enemy : enemies_["small_stone"])
+    if (!replay_player_->has_next())
     {
-        enemy->draw(render_target);
-        flev::debug::draw_debug_bounds(render_target, enemy->get_bounds());
+        // Keyboard takes over after the last recorded tick
+        LOG_INFO(
+            get_global_logger(),
+            "Replay finished after {} ticks ({}).",
+            replay_player_->get_tick(),
+            replay_player_->get_divergence_tick() < 0 ? "in sync" : "diverged"
+        );
+        replay_player_.reset();
     }
+}//!track_replay
+//---------------------------------------------------------------------------------------
 
-    // 2nd level enemies
-    for (const auto& enemy : enemies_["warrior"])
-    {
-        enemy->draw(render_target);
-        flev::debug::draw_debug_bounds(render_target, enemy->get_bounds());
-    }
-    for (const auto& enemy : enemies_["scout"])
+void Game_scene::preload_assets()
+{
+    auto& resource_manager = get_resource_manager();
+    resource_manager.preload_image(Player::texture_path);
+    resource_manager.preload_image(Bullet::texture_path);
+    resource_manager.preload_image(Enemy_bullet::texture_path);
+    for_each_enemy_archetype([&resource_manager]<typename T>(std::type_identity<T>) {
+        resource_manager.preload_image(T::texture_path);
+    });
+    for (const auto* path : {
+        "assets/controls.png",
+        "assets/heart_full.png",
+        "assets/heart_empty.png",
+        "assets/level_0_bg.png",
+        "assets/level_1_bg.jpg"
+    })
+    {
+        resource_manager.preload_texture(path);
+    }
+    resource_manager.preload_font("assets/timesnewromanpsmt.ttf");
+}//!preload_assets
+//---------------------------------------------------------------------------------------
+
+void Game_scene::build_entity_atlas()
+{
+    FLEV_PROFILE_FUNCTION();
+
+    // Decodes were queued by preload_assets(), only packing and upload happen here
+    auto& resource_manager = get_resource_manager();
+    auto& atlas = entity_atlas_.atlas;
+    entity_atlas_.player = atlas.add(*resource_manager.get_image(Player::texture_path));
+    entity_atlas_.bullet = atlas.add(*resource_manager.get_image(Bullet::texture_path));
+    entity_atlas_.enemy_bullet = atlas.add(*resource_manager.get_image(Enemy_bullet::texture_path));
+    for_each_enemy_archetype([this, &resource_manager, &atlas]<typename T>(std::type_identity<T>) {
+        const auto region = atlas.add(*resource_manager.get_image(T::texture_path));
+        entity_atlas_.enemies[to_index(T::type)] = region;
+        entity_atlas_.enemy_masks[to_index(T::type)] = atlas.get_mask(region).scaled(T::scale);
+    });
+    entity_atlas_.player_mask = atlas.get_mask(entity_atlas_.player).scaled(Player::scale);
+    entity_atlas_.bullet_mask = atlas.get_mask(entity_atlas_.bullet).scaled(Bullet::scale);
+    entity_atlas_.enemy_bullet_mask = atlas.get_mask(entity_atlas_.enemy_bullet).scaled(Enemy_bullet::scale);
+    if (!atlas.build())
     {
-        enemy->draw(render_target);
-        flev::debug::draw_debug_bounds(render_target, enemy->get_bounds());
+        LOG_ERROR(get_global_logger(), "Failed to build entity texture atlas.");
     }
-	// Enemy bullets
-    for (const auto& bullet : enemy_bullets_)
-    {
-        bullet->draw(render_target);
-        flev::debug::draw_debug_bounds(render_target, bullet->get_bounds());
-	}
-}//!draw_game_objects
+}//!build_entity_atlas
 //---------------------------------------------------------------------------------------
 
-FLEV_NODISCARD Game_state Game_scene::get_scene_type() const
-{ 
-    return Game_state::Game; 
-}//!get_scene_type
+template <typename T>
+void Game_scene::initialize_archetype()
+{
+    const auto& entity_atlas = entity_atlas_;
+    const auto& region = entity_atlas.atlas.get_region(entity_atlas.enemies[to_index(T::type)]);
+    enemy_regions_[to_index(T::type)] = region;
+    world_.set_enemy_size(T::type, get_scaled_size(region, T::scale));
+    world_.set_enemy_mask(T::type, entity_atlas.enemy_masks[to_index(T::type)]);
+}//!initialize_archetype
+//---------------------------------------------------------------------------------------
+
+void Game_scene::initialize_entities()
+{
+    FLEV_PROFILE_FUNCTION();
+
+    // All entity quads sample the entity atlas, one batch per layer
+    build_entity_atlas();
+    const auto& entity_atlas = entity_atlas_;
+    for (auto& batch : entity_batches_) batch.set_texture(&entity_atlas.atlas.get_texture());
+
+    player_region_ = entity_atlas.atlas.get_region(entity_atlas.player);
+    world_.set_player_size(get_scaled_size(player_region_, Player::scale));
+    world_.set_player_mask(entity_atlas.player_mask);
+
+    for_each_enemy_archetype([this]<typename T>(std::type_identity<T>) { initialize_archetype<T>(); });
+
+    bullet_region_ = entity_atlas.atlas.get_region(entity_atlas.bullet);
+    enemy_bullet_region_ = entity_atlas.atlas.get_region(entity_atlas.enemy_bullet);
+    world_.set_bullet_sizes(
+        get_scaled_size(bullet_region_, Bullet::scale),
+        get_scaled_size(enemy_bullet_region_, Enemy_bullet::scale)
+    );
+    world_.set_bullet_masks(entity_atlas.bullet_mask, entity_atlas.enemy_bullet_mask);
+}//!initialize_entities
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD sf::Vector2f Game_scene::get_scaled_size(const sf::IntRect& region, const sf::Vector2f& scale)
+{
+    return { region.size.x * scale.x, region.size.y * scale.y };
+}//!get_scaled_size
 //---------------------------------------------------------------------------------------
 
 void Game_scene::initialize_sky(const sf::Vector2u& window_size)
 {
-    switch (current_level_id_)
+    FLEV_PROFILE_FUNCTION();
+
+    switch (world_.get_level_id())
     {
     case 0:
     {
         // Load sky texture
-        if (!ui_textures_.contains("level_0_bg") &&
-            !ui_textures_["level_0_bg"].loadFromFile("assets/level_0_bg.png"))
+        ui_textures_[Ui_texture::Sky] = get_resource_manager().get_texture("assets/level_0_bg.png");
+        const sf::Texture& sky_texture = *ui_textures_[Ui_texture::Sky];
+        if (sky_texture.getSize().x == 0)
         {
-			LOG_ERROR(get_global_logger(), "Failed to load level '{}' background.", current_level_id_);
+			LOG_ERROR(get_global_logger(), "Failed to load level '{}' background.", world_.get_level_id());
             return;
         }
-        sf::Texture& sky_texture = ui_textures_["level_0_bg"];
 
         // Sky
         sky_sprites_.emplace_back(std::make_unique<sf::Sprite>(sky_texture));
@@ -436,13 +542,13 @@ void Game_scene::initialize_sky(const sf::Vector2u& window_size)
     case 1:
     {
         // Load sky texture
-        if (!ui_textures_.contains("level_1_bg") &&
-            !ui_textures_["level_1_bg"].loadFromFile("assets/level_1_bg.jpg"))
+        ui_textures_[Ui_texture::Sky] = get_resource_manager().get_texture("assets/level_1_bg.jpg");
+        const sf::Texture& sky_texture = *ui_textures_[Ui_texture::Sky];
+        if (sky_texture.getSize().x == 0)
         {
-            LOG_ERROR(get_global_logger(), "Failed to load level '{}' background.", current_level_id_);
+            LOG_ERROR(get_global_logger(), "Failed to load level '{}' background.", world_.get_level_id());
             return;
         }
-        sf::Texture& sky_texture = ui_textures_["level_1_bg"];
 
         // Sky
         sky_sprites_.emplace_back(std::make_unique<sf::Sprite>(sky_texture));
@@ -461,13 +567,12 @@ void Game_scene::initialize_sky(const sf::Vector2u& window_size)
 
 void Game_scene::initialize_ui(const sf::Vector2u& window_size)
 {
+    FLEV_PROFILE_FUNCTION();
+
     // Controls
-    if (!ui_textures_.contains("controls") &&
-        !ui_textures_["controls"].loadFromFile("assets/controls.png"))
-    {
-		LOG_ERROR(get_global_logger(), "Failed to load controls texture.");
-    }
-    auto& controls_texture = ui_textures_["controls"];
+    auto& resource_manager = get_resource_manager();
+    ui_textures_[Ui_texture::Controls] = resource_manager.get_texture("assets/controls.png");
+    const sf::Texture& controls_texture = *ui_textures_[Ui_texture::Controls];
 	controls_ = std::make_unique<sf::Sprite>(controls_texture);
     controls_->setScale({ 0.2f,  0.2f });
     controls_->setPosition({
@@ -476,18 +581,12 @@ void Game_scene::initialize_ui(const sf::Vector2u& window_size)
     });
 
     // Health icons
-    if (!ui_textures_.contains("heart_full") &&
-        !ui_textures_["heart_full"].loadFromFile("assets/heart_full.png"))
-    {
-		LOG_ERROR(get_global_logger(), "Failed to load full health icon texture.");
-    }
-    if (!ui_textures_.contains("heart_empty") &&
-        !ui_textures_["heart_empty"].loadFromFile("assets/heart_empty.png"))
-    {
-        LOG_ERROR(get_global_logger(), "Failed to load empty health icon texture.");
-    }
-    auto& heart_texture = ui_textures_["heart_full"];
-    for (int i = 0; i < player_.get_max_hp(); ++i)
+    resource_manager.preload_texture("assets/heart_empty.png");
+    ui_textures_[Ui_texture::Heart_full] = resource_manager.get_texture("assets/heart_full.png");
+    const sf::Texture& heart_texture = *ui_textures_[Ui_texture::Heart_full];
+    ui_textures_[Ui_texture::Heart_empty] = resource_manager.get_texture("assets/heart_empty.png");
+    shown_hp_ = world_.get_player().get_hp();
+    for (int i = 0; i < world_.get_player().get_max_hp(); ++i)
     {
         auto icon = std::make_unique<sf::Sprite>(heart_texture);
         icon->setScale({ 0.1f, 0.1f });
@@ -496,29 +595,25 @@ void Game_scene::initialize_ui(const sf::Vector2u& window_size)
     }
 
     // Labels
-    if (!ui_font_.openFromFile("assets/timesnewromanpsmt.ttf"))
-    {
-		LOG_ERROR(get_global_logger(), "Failed to load UI font.");
-    }
+    ui_font_ = resource_manager.get_font("assets/timesnewromanpsmt.ttf");
 
-    switch (current_level_id_)
+    switch (world_.get_level_id())
     {
     case 0:
     {
-        win_cond_label_ = Label(std::format("До станции осталось: {} миль.", level_duration_ / 2), ui_font_, 30);
+        win_cond_label_ = Label(std::format("До станции осталось: {} миль.", world_.get_level_duration() / 2), *ui_font_, 30);
         win_cond_label_.set_color(sf::Color::White);
         break;
     }
     case 1:
     {
-		const auto total_enemies = total_scout_enemies_ + total_warrior_enemies_;
-        win_cond_label_ = Label(std::format("Противников осталось: {}", total_enemies), ui_font_, 30);
+        win_cond_label_ = Label(std::format("Противников осталось: {}", world_.get_remaining_enemies()), *ui_font_, 30);
         win_cond_label_.set_color(sf::Color::White);
         break;
     }
     case 2:
     {
-        win_cond_label_ = Label("Вы в зоне повышенной опасности!", ui_font_, 30);
+        win_cond_label_ = Label("Вы в зоне повышенной опасности!", *ui_font_, 30);
         win_cond_label_.set_color(sf::Color::Red);
         break;
     }
@@ -529,6 +624,8 @@ void Game_scene::initialize_ui(const sf::Vector2u& window_size)
 
 void Game_scene::initialize_pause_menu(const sf::Vector2u& window_size)
 {
+    FLEV_PROFILE_FUNCTION();
+
     // Shading
     pause_overlay_.setSize(sf::Vector2f(
         static_cast<float>(window_size.x),
@@ -545,104 +642,108 @@ void Game_scene::initialize_pause_menu(const sf::Vector2u& window_size)
     });
 
     // Buttons
-    pause_buttons_.emplace("resume", std::make_unique<Button>(
+    pause_buttons_[Pause_action::Resume] = std::make_unique<Button>(
         sf::FloatRect({ 0, 0 }, { 200.f, 50.f }),
         "Продолжить",
-        ui_font_,
+        *ui_font_,
         30u
-    ));
-    pause_buttons_.emplace("menu", std::make_unique<Button>(
+    );
+    pause_buttons_[Pause_action::Menu] = std::make_unique<Button>(
         sf::FloatRect({ 0, 0 }, { 200.f, 50.f }),
         "В меню",
-        ui_font_,
+        *ui_font_,
         30u
-    ));
-    pause_buttons_.emplace("exit", std::make_unique<Button>(
+    );
+    pause_buttons_[Pause_action::Exit] = std::make_unique<Button>(
         sf::FloatRect({ 0, 0 }, { 200.f, 50.f }),
         "Выйти",
-        ui_font_,
+        *ui_font_,
         30u
-    ));
+    );
 
     // Positioning buttons on the panel
     const auto panel_pos = pause_panel_->get_bounds().position;
     const auto panel_center = pause_panel_->get_bounds().getCenter();
 
-    pause_buttons_["resume"]->set_position({ panel_center.x - 100.f, panel_pos.y + 60.f });
-    pause_buttons_["menu"]->set_position({ panel_center.x - 100.f, panel_pos.y + 130.f });
-    pause_buttons_["exit"]->set_position({ panel_center.x - 100.f, panel_pos.y + 200.f });
+    pause_buttons_[Pause_action::Resume]->set_position({ panel_center.x - 100.f, panel_pos.y + 60.f });
+    pause_buttons_[Pause_action::Menu]->set_position({ panel_center.x - 100.f, panel_pos.y + 130.f });
+    pause_buttons_[Pause_action::Exit]->set_position({ panel_center.x - 100.f, panel_pos.y + 200.f });
 }//!initialize_pause_menu
 //---------------------------------------------------------------------------------------
 
-void Game_scene::spawn_enemy()
+void Game_scene::update_sky(const float dt)
 {
-	// If level has a duration, do not spawn enemies in the last 5 seconds
-    if (level_duration_ > 0 && 
-        level_timer_.getElapsedTime().asSeconds() > level_duration_ - 5)
+	// Only level 0 has scrolling sky
+    if (world_.get_level_id() != 0) return;
+
+    float scroll_speed_ = world_.get_player().get_speed() * 0.4f;
+    for (const auto& sky : sky_sprites_)
     {
-		return;
+        sky->move({ -scroll_speed_ * dt, 0 });
     }
-	static uint8_t wave_number = 0;
-    auto win_size = main_window_.get_window_size();
 
-    switch (current_level_id_)
+    float sky_width = sky_sprites_[0]->getGlobalBounds().size.x;
+    if (sky_sprites_[0]->getPosition().x + sky_width < 0)
+        sky_sprites_[0]->setPosition({ sky_sprites_[1]->getPosition().x + sky_width, 0 });
+    if (sky_sprites_[1]->getPosition().x + sky_width < 0)
+        sky_sprites_[1]->setPosition({ sky_sprites_[0]->getPosition().x + sky_width, 0 });
+
+}//!update_sky
+//---------------------------------------------------------------------------------------
+
+void Game_scene::update_win_cond_label()
+{
+    // Formatted into scratch memory, the label copies it
+    std::pmr::string text(scratch_.get_resource());
+    if (world_.get_level_duration() > 0)
     {
-    case 0: // Meteors
+        const auto remaining = static_cast<int32_t>(world_.get_remaining_time());
+        std::format_to(std::back_inserter(text), "До станции осталось: {} миль.", std::max(0, remaining / 2));
+    }
+    if (world_.get_level_id() == 1)
     {
-        const float x = static_cast<float>(rand() % (win_size.x) + win_size.x / 6);
-        if (wave_number++ % 3)
-        {
-            enemies_["big_stone"].emplace_back(std::make_unique<Big_stone>(sf::Vector2f(x + 150, -100)));
-        }
-        enemies_["small_stone"].emplace_back(std::make_unique<Small_stone>(sf::Vector2f(x + 50, -100)));
-        break;
+        text.clear();
+        std::format_to(std::back_inserter(text), "Противников осталось: {}", world_.get_remaining_enemies());
     }
-    case 1: // Ships
+    if (!text.empty()) win_cond_label_.set_text(text);
+}//!update_win_cond_label
+//---------------------------------------------------------------------------------------
+
+void Game_scene::save_previous_state()
+{
+    sky_prev_x_.resize(sky_sprites_.size());
+    for (size_t i = 0; i < sky_sprites_.size(); ++i) sky_prev_x_[i] = sky_sprites_[i]->getPosition().x;
+}//!save_previous_state
+//---------------------------------------------------------------------------------------
+
+void Game_scene::draw_sky(sf::RenderTarget& render_target)
+{
+    for (size_t i = 0; i < sky_sprites_.size(); ++i)
     {
-        if (wave_number++ % 3 == 0)
-        {
-			// Spawn scouts (2 per every third wave)
-            for (size_t i = 0; i < 2; i++)
-            {
-                if (enemies_["scout"].size() >= total_scout_enemies_)
-                {
-                    break;
-                }
-                const float y = static_cast<float>(rand() % (win_size.y - 100u) + 50.f);
-                enemies_["scout"].emplace_back(std::make_unique<Scout>(sf::Vector2f(win_size.x + 50, y)));
-            }
-        }
-        else
+        auto& sky = *sky_sprites_[i];
+        const auto position = sky.getPosition();
+        const auto prev_x = i < sky_prev_x_.size() ? sky_prev_x_[i] : position.x;
+
+        // Do not blend across the wrap-around jump
+        if (std::abs(position.x - prev_x) < sky.getGlobalBounds().size.x / 2.f)
         {
-            if (enemies_["warrior"].size() >= total_warrior_enemies_)
-            {
-                break;
-            }
-            const float y = static_cast<float>(rand() % (win_size.y / 2u));
-            enemies_["warrior"].emplace_back(std::make_unique<Warrior>(sf::Vector2f(win_size.x + 50, y)));
+            sky.setPosition({ prev_x + (position.x - prev_x) * render_alpha_, position.y });
         }
-        break;
+        draw_counted(render_target, sky);
+        sky.setPosition(position);
     }
-    }
-}//!spawn_enemy
+}//!draw_sky
 //---------------------------------------------------------------------------------------
 
-void Game_scene::update_sky(const float dt)
+void Game_scene::sync_health_icons()
 {
-	// Only level 0 has scrolling sky
-    if (current_level_id_ != 0) return;
+    const auto hp = world_.get_player().get_hp();
+    if (hp == shown_hp_) return;
 
-    float scroll_speed_ = player_.get_speed() * 0.4f;
-    for (const auto& sky : sky_sprites_)
+    for (size_t i = hp; i < shown_hp_ && i < health_icons_.size(); ++i)
     {
-        sky->move({ -scroll_speed_ * dt, 0 });
+        health_icons_[i]->setTexture(*ui_textures_[Ui_texture::Heart_empty]);
     }
-
-    float sky_width = sky_sprites_[0]->getGlobalBounds().size.x;
-    if (sky_sprites_[0]->getPosition().x + sky_width < 0)
-        sky_sprites_[0]->setPosition({ sky_sprites_[1]->getPosition().x + sky_width, 0 });
-    if (sky_sprites_[1]->getPosition().x + sky_width < 0)
-        sky_sprites_[1]->setPosition({ sky_sprites_[0]->getPosition().x + sky_width, 0 });
-
-}//!update_sky
-//---------------------------------------------------------------------------------------
\ No newline at end of file
+    shown_hp_ = hp;
+}//!sync_health_icons
+//---------------------------------------------------------------------------------------
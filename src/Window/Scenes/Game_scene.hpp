@@ -3,11 +3,17 @@
 #include <UI/Panel.hpp>
 #include <UI/Button.hpp>
 #include "Scene.hpp"
-#include <Entities/Enemy.hpp>
-#include <Entities/Player.hpp>
-#include <Entities/Bullet.hpp>
+#include <Level/Game_world.hpp>
+#include <Level/Replay.hpp>
+#include <Render/Texture_atlas.hpp>
+#include <Render/Sprite_batch.hpp>
+#include <Render/Debug_draw.hpp>
+#include <utils/enum_array.hpp>
+#include <utils/arena.hpp>
 #include <vector>
+#include <array>
 #include <memory>
+#include <optional>
 
 class Game_scene final : public Scene
 {
@@ -16,20 +22,112 @@ public:
     /** @brief Constructs game scene for the given level. */
     Game_scene(Main_window& window, const int32_t level_id);
 
+    /** @brief Logs bullet pool and simulation phase statistics. */
+    ~Game_scene() override;
+
     /** @brief Handles pause menu events and Escape key. */
     void handle_event(const sf::Event& event) override;
 
-    /** @brief Updates all game logic, collisions, and win/lose conditions. */
+    /** @brief Advances the game world and reacts to win/lose conditions. */
     void update(const float dt) override;
 
+    /** @returns Requested simulation speed (fast-forward while Tab is held). */
+    FLEV_NODISCARD float get_time_scale() const override;
+
+    /** @brief Stores blend factor used to interpolate entity positions while drawing. */
+    void set_interpolation_alpha(const float alpha) override;
+
     /** @brief Draws UI, game objects, and pause overlay if needed. */
     void draw(sf::RenderTarget& render_target) override;
 
+    /** @brief Appends live bullet and per-archetype enemy counts. */
+    void get_hud_counters(std::vector<Hud_counter>& counters) const override;
+
     /** @brief Returns Game_state::Game. */
     FLEV_NODISCARD Game_state get_scene_type() const override;
 
+    /** @brief Queues decoding of entity images, UI textures and font of the scene (see Resource_manager). */
+    static void preload_assets();
+
+private/*types*/:
+
+    /** @brief Gameplay draw layers (drawn in declaration order, one draw call each). */
+    enum class Entity_layer : uint8_t
+    {
+        Player,        ///< Player and player bullets.
+        Enemies,       ///< All enemy archetypes.
+        Enemy_bullets, ///< Enemy bullets (on top of ships).
+
+        Count
+    };
+
+    /** @brief UI textures held by the scene. */
+    enum class Ui_texture : uint8_t
+    {
+        Sky,         ///< Level background.
+        Controls,    ///< Controls hint.
+        Heart_full,  ///< Health icon.
+        Heart_empty, ///< Lost health icon.
+
+        Count
+    };
+
+    /** @brief Pause menu button actions. */
+    enum class Pause_action : uint8_t
+    {
+        Resume,
+        Menu,
+        Exit,
+
+        Count
+    };
+
+    /** @returns Batch index of the given layer. */
+    static constexpr size_t layer_index(const Entity_layer layer) { return static_cast<size_t>(layer); }
+
+    /** @brief Entity textures packed into one atlas. */
+    struct Entity_atlas
+    {
+        Texture_atlas atlas;                                              ///< Packed entity textures.
+        Texture_atlas::Region_id player = 0u;                             ///< Player region.
+        Texture_atlas::Region_id bullet = 0u;                             ///< Player bullet region.
+        Texture_atlas::Region_id enemy_bullet = 0u;                       ///< Enemy bullet region.
+        std::array<Texture_atlas::Region_id, enemy_type_count> enemies{}; ///< Region per enemy archetype.
+
+        // Collision masks at sprite scale
+        Collision_mask player_mask;                                       ///< Player ship.
+        Collision_mask bullet_mask;                                       ///< Player bullet.
+        Collision_mask enemy_bullet_mask;                                 ///< Enemy bullet.
+        std::array<Collision_mask, enemy_type_count> enemy_masks;         ///< Mask per enemy archetype.
+    };
+
 private/*methods*/:
 
+    /** @brief Pauses or resumes simulation time. */
+    void toggle_pause();
+
+    /** @returns Player controls read from the keyboard (arrows/WASD, Space). */
+    FLEV_NODISCARD static Player_input poll_player_input();
+
+    /** @returns Replay requested for playback if it matches the level (seeds the world). */
+    FLEV_NODISCARD static std::optional<Replay> load_playback(const Main_window& window, const int32_t level_id);
+
+    /** @brief Records the executed tick and checks it against the played replay. */
+    void track_replay(const Player_input& input);
+
+    /** @brief Packs entity images (decoded by the resource worker) into entity_atlas_. */
+    void build_entity_atlas();
+
+    /** @brief Looks up atlas regions of entities and passes their sizes to the game world. */
+    void initialize_entities();
+
+    /** @brief Looks up atlas region and sets sprite size for enemy archetype T. */
+    template <typename T>
+    void initialize_archetype();
+
+    /** @returns Size of an atlas region drawn with the given scale. */
+    FLEV_NODISCARD static sf::Vector2f get_scaled_size(const sf::IntRect& region, const sf::Vector2f& scale);
+
     /** @brief Initializes parallax background based on level. */
     void initialize_sky(const sf::Vector2u& window_size);
 
@@ -43,47 +141,66 @@ private/*methods*/:
      * @brief Draws only gameplay entities (sky, player, enemies, bullets).
      *
      * Used for both main rendering and game over screenshot.
+     *
+     * @param alpha[in] - Interpolation factor between previous and current tick.
      */
-    void draw_game_objects(sf::RenderTarget& render_target);
+    void draw_game_objects(sf::RenderTarget& render_target, const float alpha);
 
-    /** @brief Spawns enemies according to current level rules. */
-    void spawn_enemy();
+    /** @brief Adds broadphase cells and spawn points to enabled debug channels. */
+    void add_debug_geometry(Debug_draw& debug_draw);
+
+    /** @brief Draws background layers at interpolated scroll position. */
+    void draw_sky(sf::RenderTarget& render_target);
+
+    /** @brief Remembers sky layer positions before a tick (for interpolation). */
+    void save_previous_state();
 
     /** @brief Updates scrolling sky (level 0 only). */
     void update_sky(const float dt);
 
+    /** @brief Updates win condition text from the world state. */
+    void update_win_cond_label();
+
+    /** @brief Switches health icons to empty for lost HP. */
+    void sync_health_icons();
+
 private/*vars*/:
 
     // -----------------------------------------------------------------------
-    // Level state
+    // Memory (declared first, released after everything allocated from it)
     // -----------------------------------------------------------------------
-    const int32_t current_level_id_; ///< Current level ID.
-    float level_duration_ = 120.f;   ///< Time limit for timed levels (seconds).
-    sf::Clock level_timer_;          ///< Elapsed time since level start.
+    static constexpr size_t scratch_capacity_ = 16u * 1024u; ///< Frame scratch buffer size (bytes).
+    Level_arena level_arena_;                                ///< Backs all level-lifetime containers, freed with the scene.
+    Scratch_arena scratch_;                                  ///< Transient text and debug geometry, reset every tick and frame.
 
     // -----------------------------------------------------------------------
-    // Game entities
+    // Simulation
     // -----------------------------------------------------------------------
-    Player player_;                                                      ///< Player ship.
-    std::map<std::string, std::vector<std::unique_ptr<Enemy>>> enemies_; ///< Enemies by type.
-    std::vector<std::unique_ptr<Bullet>> bullets_;                       ///< Player-fired bullets.
-    std::vector<std::unique_ptr<Bullet>> enemy_bullets_;                 ///< Enemy-fired bullets.
+    std::optional<Replay> playback_;             ///< Played replay (declared before world_, provides its seed).
+    Game_world world_;                           ///< Gameplay simulation of the current level.
+    std::optional<Replay_player> replay_player_; ///< Playback cursor (input source while set).
+    std::optional<Replay> recording_;            ///< Run being recorded (if requested).
+    uint32_t shown_hp_ = 0u;                     ///< Player HP currently shown by health icons.
 
     // -----------------------------------------------------------------------
-    // Game state
+    // Entity rendering (quads batched per layer, sampled from the entity atlas)
     // -----------------------------------------------------------------------
-    int32_t score_ = 0;                   ///< Current score (accumulated during level).
-    uint16_t total_scout_enemies_ = 16u;  ///< Remaining scout enemies (level 1).
-    uint16_t total_warrior_enemies_ = 8u; ///< Remaining warrior enemies (level 1).
+    Entity_atlas entity_atlas_;                                 ///< Packed entity textures and masks.
+    sf::IntRect player_region_;                                 ///< Player atlas region.
+    std::array<sf::IntRect, enemy_type_count> enemy_regions_;   ///< Atlas region per enemy archetype.
+    sf::IntRect bullet_region_;                                 ///< Player bullet atlas region.
+    sf::IntRect enemy_bullet_region_;                           ///< Enemy bullet atlas region.
+    std::array<Sprite_batch, static_cast<size_t>(Entity_layer::Count)> entity_batches_; ///< Vertex batch per layer.
 
     // -----------------------------------------------------------------------
     // UI resources
     // -----------------------------------------------------------------------
-    sf::Font ui_font_;                                      ///< Font for all on-screen text.
+    Font_handle ui_font_;                                   ///< Font for all on-screen text.
 
-    std::map<std::string, sf::Texture> ui_textures_;        ///< Loaded UI textures (hearts, controls, backgrounds).
+    Enum_array<Ui_texture, Texture_handle> ui_textures_;    ///< Loaded UI textures (hearts, controls, background).
 
     std::vector<std::unique_ptr<sf::Sprite>> sky_sprites_;  ///< Background parallax layers.
+    std::vector<float> sky_prev_x_;                         ///< Layer x before the last tick (for interpolation).
     std::vector<std::unique_ptr<sf::Sprite>> health_icons_; ///< Player health indicators (full/empty).
     std::unique_ptr<sf::Sprite> controls_;                  ///< Controls hint icon.
 
@@ -95,15 +212,13 @@ private/*vars*/:
     // -----------------------------------------------------------------------
     // Pause menu
     // -----------------------------------------------------------------------
-    bool paused_ = false;                                          ///< Whether game logic is paused.
     sf::RectangleShape pause_overlay_;                             ///< Semi-transparent dimming layer.
     std::unique_ptr<Panel> pause_panel_;                           ///< Pause menu background panel.
-    std::map<std::string, std::unique_ptr<Button>> pause_buttons_; ///< Pause menu buttons.
+    Enum_array<Pause_action, std::unique_ptr<Button>> pause_buttons_; ///< Pause menu buttons.
 
     // -----------------------------------------------------------------------
     // Timing
     // -----------------------------------------------------------------------
-    float spawn_time_ = 5.f; ///< Base enemy spawn interval (seconds).
-    sf::Clock spawn_clock_;  ///< Timer for next enemy spawn.
-    sf::Clock fps_clock_;    ///< Unused (for debugging).
+    static constexpr float fast_forward_scale_ = 4.f; ///< Time scale while Tab is held.
+    float render_alpha_ = 1.f;                        ///< Interpolation factor between previous and current tick.
 };
\ No newline at end of file
@@ -2,7 +2,6 @@
 #include "../Main_window.hpp"
 #include "../Leaderboard_entry.hpp"
 
-#include <utils/debug_bounds.hpp>
 
 Leaderboard_scene::Leaderboard_scene(Main_window& window, const std::vector<Leaderboard_entry>& entries)
     : Scene(window), entries_(entries)
@@ -10,14 +9,11 @@ Leaderboard_scene::Leaderboard_scene(Main_window& window, const std::vector<Lead
     const auto window_size = window.get_window_size();
 
 	// Background
-    if (!background_tex_.loadFromFile("assets/main_menu_bg.png"))
-    {
-        LOG_ERROR(get_global_logger(), "Failed to load background texture for leaderboards.");
-    }
-    background_ = std::make_unique<sf::Sprite>(background_tex_);
+    background_tex_ = get_resource_manager().get_texture("assets/main_menu_bg.png");
+    background_ = std::make_unique<sf::Sprite>(*background_tex_);
     background_->setScale({
-        static_cast<float>(window_size.x) / background_tex_.getSize().x,
-        static_cast<float>(window_size.y) / background_tex_.getSize().y
+        static_cast<float>(window_size.x) / background_tex_->getSize().x,
+        static_cast<float>(window_size.y) / background_tex_->getSize().y
     });
 
     // Overlay
@@ -31,12 +27,9 @@ Leaderboard_scene::Leaderboard_scene(Main_window& window, const std::vector<Lead
     panel_->set_position({ (window_size.x - panel_w) / 2.f, (window_size.y - panel_h) / 2.f });
 
     // Font
-    if (!font_.openFromFile("assets/timesnewromanpsmt.ttf"))
-    {
-		LOG_ERROR(get_global_logger(), "Failed to load font for leaderboard scene.");
-    }
+    font_ = get_resource_manager().get_font("assets/timesnewromanpsmt.ttf");
 
-	panel_->set_title("Таблица лидеров", font_, 30);
+	panel_->set_title("Таблица лидеров", *font_, 30);
 
 	// Calculate visible entries
     visible_entries_ = static_cast<int32_t>(panel_h / entry_height_) - 2;
@@ -67,8 +60,8 @@ void Leaderboard_scene::handle_event(const sf::Event& event)
 
 void Leaderboard_scene::draw(sf::RenderTarget& render_target)
 {
-    render_target.draw(*background_);
-    render_target.draw(overlay_);
+    draw_counted(render_target, *background_);
+    draw_counted(render_target, overlay_);
     panel_->draw(render_target);
 
 	// Draw entries
@@ -110,10 +103,8 @@ void Leaderboard_scene::render_entries(sf::RenderTarget& render_target)
         if (vrow.type == Virtual_row::Type::Player_header)
         {
             const auto& entry = entries_[vrow.player_index];
-            int total = 0;
-            for (int s : entry.score_per_level_id) total += s;
             text = std::format("{}. {} — Всего: {}",
-                vrow.player_index + 1, entry.name, total);
+                vrow.player_index + 1, entry.name, entry.total_score);
         }
 		else // Level_detail
         {
@@ -122,7 +113,7 @@ void Leaderboard_scene::render_entries(sf::RenderTarget& render_target)
             text = std::format("\tУровень {}: {}", vrow.level_id + 1, score);
         }
 
-        Label label(text, font_, vrow.type == Virtual_row::Type::Player_header ? 26 : 22);
+        Label label(text, *font_, vrow.type == Virtual_row::Type::Player_header ? 26 : 22);
         label.set_position({
             panel_bounds.position.x + 30.f,
             start_y + (i - first_visible) * entry_height_ - scroll_offset_ + (first_visible * entry_height_)
@@ -44,9 +44,9 @@ private/*methods*/:
 
 private/*vars*/:
 
-    sf::Font font_;                                   ///< Font for all text elements.
+    Font_handle font_;                                ///< Font for all text elements.
 
-    sf::Texture background_tex_;                      ///< Background texture (main menu style).
+    Texture_handle background_tex_;                   ///< Background texture (main menu style).
     std::unique_ptr<sf::Sprite> background_;          ///< Scaled background sprite.
     sf::RectangleShape overlay_;                      ///< Semi-transparent dimming layer.
     std::unique_ptr<Decorated_panel> panel_;          ///< Panel with title and content area.
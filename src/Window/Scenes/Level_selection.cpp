@@ -9,14 +9,11 @@ Level_selection_scene::Level_selection_scene(Main_window& window)
     const auto window_size = window.get_window_size();
 
 	// Background
-    if (!background_tex_.loadFromFile("assets/main_menu_bg.png"))
-    {
-        LOG_ERROR(get_global_logger(), "Failed to load background texture for level_selection.");
-    }
-    background_ = std::make_unique<sf::Sprite>(background_tex_);
+    background_tex_ = get_resource_manager().get_texture("assets/main_menu_bg.png");
+    background_ = std::make_unique<sf::Sprite>(*background_tex_);
     background_->setScale({
-        static_cast<float>(window_size.x) / background_tex_.getSize().x,
-        static_cast<float>(window_size.y) / background_tex_.getSize().y
+        static_cast<float>(window_size.x) / background_tex_->getSize().x,
+        static_cast<float>(window_size.y) / background_tex_->getSize().y
     });
 
 	// Shading overlay
@@ -27,10 +24,7 @@ Level_selection_scene::Level_selection_scene(Main_window& window)
     overlay_.setFillColor(sf::Color(40, 40, 60, 200));
 
     // Font
-    if (!font_.openFromFile("assets/timesnewromanpsmt.ttf"))
-    {
-		LOG_ERROR(get_global_logger(), "Failed to load font for level selection scene.");   
-    }
+    font_ = get_resource_manager().get_font("assets/timesnewromanpsmt.ttf");
 
 	// Level buttons
     const auto num_levels = window.get_max_level_id() + 1;
@@ -54,7 +48,7 @@ Level_selection_scene::Level_selection_scene(Main_window& window)
         auto btn = std::make_unique<Button>(
             sf::FloatRect({0, 0}, {button_width, button_height}),
             label,
-            font_,
+            *font_,
             32u
         );
 
@@ -69,7 +63,7 @@ Level_selection_scene::Level_selection_scene(Main_window& window)
     back_button_ = std::make_unique<Button>(
         sf::FloatRect({0, 0}, {150.f, 40.f}),
         "Назад",
-        font_,
+        *font_,
         24u
     );
     back_button_->set_position({
@@ -131,8 +125,8 @@ void Level_selection_scene::handle_event(const sf::Event& event)
 
 void Level_selection_scene::draw(sf::RenderTarget& render_target)
 {
-	render_target.draw(*background_);
-    render_target.draw(overlay_);
+	draw_counted(render_target, *background_);
+    draw_counted(render_target, overlay_);
 	panel_->draw(render_target);
 
     for (const auto& btn : level_buttons_)
@@ -7,14 +7,11 @@ Login_scene::Login_scene(Main_window& window): Scene(window)
     const auto window_size = window.get_window_size();
     
 	// Background
-    if (!background_tex_.loadFromFile("assets/main_menu_bg.png"))
-    {
-		LOG_ERROR(get_global_logger(), "Failed to load login scene background texture.");
-    }
-    background_ = std::make_unique<sf::Sprite>(background_tex_);
+    background_tex_ = get_resource_manager().get_texture("assets/main_menu_bg.png");
+    background_ = std::make_unique<sf::Sprite>(*background_tex_);
     background_->setScale({
-        static_cast<float>(window_size.x) / background_tex_.getSize().x,
-        static_cast<float>(window_size.y) / background_tex_.getSize().y
+        static_cast<float>(window_size.x) / background_tex_->getSize().x,
+        static_cast<float>(window_size.y) / background_tex_->getSize().y
     });
 
     // Overlay
@@ -22,10 +19,7 @@ Login_scene::Login_scene(Main_window& window): Scene(window)
     overlay_.setFillColor(sf::Color(40, 40, 60, 200));
 
 	// Font
-    if (!font_.openFromFile("assets/timesnewromanpsmt.ttf"))
-    {
-		LOG_ERROR(get_global_logger(), "Failed to load font for login scene.");
-    }
+    font_ = get_resource_manager().get_font("assets/timesnewromanpsmt.ttf");
 
     // Panel
     panel_ = std::make_unique<Panel>(sf::Vector2f{ 500.f, 300.f });
@@ -36,7 +30,7 @@ Login_scene::Login_scene(Main_window& window): Scene(window)
     const auto panel_bounds = panel_->get_bounds();
 
     // Header
-    title_label_ = Label("Введите ваше имя:", font_, 40);
+    title_label_ = Label("Введите ваше имя:", *font_, 40);
     title_label_.set_position({
         panel_bounds.position.x + 50.f,
         panel_bounds.position.y + 30.f
@@ -44,7 +38,7 @@ Login_scene::Login_scene(Main_window& window): Scene(window)
     title_label_.set_color(sf::Color::White);
 
     // Input field
-    input_label_ = Label("_", font_, 36);
+    input_label_ = Label("_", *font_, 36);
     input_label_.set_position({
         panel_bounds.position.x + 50.f,
         panel_bounds.position.y + 100.f
@@ -55,7 +49,7 @@ Login_scene::Login_scene(Main_window& window): Scene(window)
     confirm_button_ = std::make_unique<Button>(
         sf::FloatRect({ 0, 0 }, { 200.f, 50.f }),
         "Готово",
-        font_,
+        *font_,
         30
     );
     confirm_button_->set_position({
@@ -125,8 +119,8 @@ void Login_scene::update(const float dt)
 
 void Login_scene::draw(sf::RenderTarget& render_target)
 {
-	render_target.draw(*background_);
-    render_target.draw(overlay_);
+	draw_counted(render_target, *background_);
+    draw_counted(render_target, overlay_);
 
     panel_->draw(render_target);
     title_label_.draw(render_target);
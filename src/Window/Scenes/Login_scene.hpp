@@ -32,7 +32,7 @@ public:
 
 private:
 
-    sf::Font font_;                          ///< Font used in the scene.
+    Font_handle font_;                       ///< Font used in the scene.
 
 	sf::RectangleShape overlay_;             ///< Semi-transparent dimming layer.
     std::unique_ptr<Panel> panel_;           ///< Central panel for UI elements.
@@ -40,7 +40,7 @@ private:
     Label input_label_;                      ///< Dynamic field showing current input and cursor.
     std::unique_ptr<Button> confirm_button_; ///< Button to confirm and proceed to main menu.
 
-    sf::Texture background_tex_;             ///< Background texture (shared with main menu).
+    Texture_handle background_tex_;          ///< Background texture (shared with main menu).
     std::unique_ptr<sf::Sprite> background_; ///< Background sprite (scaled to window).
 
     sf::String player_name_;                 ///< Player name in UTF-32 for safe Unicode input.
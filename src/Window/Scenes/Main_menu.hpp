@@ -2,7 +2,7 @@
 #include "scene.hpp"
 #include <UI/Label.hpp>
 #include <UI/Button.hpp>
-#include <map>
+#include <utils/enum_array.hpp>
 
 class Main_menu final : public Scene
 {
@@ -23,13 +23,26 @@ public:
     /** @brief Returns Game_state::Main_Menu. */
     FLEV_NODISCARD Game_state get_scene_type() const override;
 
-private:
+private/*types*/:
 
-    sf::Font font_; ///< Font used for all text elements.
+    /** @brief Menu button actions. */
+    enum class Action : uint8_t
+    {
+        Continue,
+        Start,
+        Leaderboard,
+        Exit,
 
-    sf::Texture background_tex_;             ///< Background texture.
+        Count
+    };
+
+private/*vars*/:
+
+    Font_handle font_; ///< Font used for all text elements.
+
+    Texture_handle background_tex_;          ///< Background texture.
     std::unique_ptr<sf::Sprite> background_; ///< Scaled background sprite.
 
     std::unique_ptr<Button> player_name_;    ///< Non-interactive display of player name.
-    std::map<std::string, std::unique_ptr<Button>> buttons_; ///< Interactive menu buttons by action name.
+    Enum_array<Action, std::unique_ptr<Button>> buttons_; ///< Interactive menu buttons by action.
 };
\ No newline at end of file
@@ -1,9 +1,13 @@
 #pragma once
 #include <utils/defines.hpp>
 #include <SFML/Graphics.hpp>
+#include <Resources/Resource_manager.hpp>
+#include <Render/Render_stats.hpp>
 #include "Game_state.hpp"
+#include <vector>
 
 class Main_window; // Forward declaration
+struct Hud_counter; // Forward declaration
 
 /** @brief Base interface for all scenes (menu, game, pause, etc.). */
 class Scene
@@ -20,9 +24,26 @@ public:
 	/** @brief Updates scene logic. */
     virtual void update(float dt) = 0;
 
+	/** @returns Requested simulation speed relative to real time (1 for real time). */
+    virtual FLEV_NODISCARD float get_time_scale() const { return 1.f; }
+
+	/**
+	 * @brief Sets how far rendering is between the previous and current simulation tick.
+	 *
+	 * @param alpha[in] - Blend factor in [0, 1]. Scenes without moving objects ignore it.
+	 */
+    virtual void set_interpolation_alpha(const float alpha) { (void)alpha; }
+
 	/** @brief Draws the scene onto the given render target. */
     virtual void draw(sf::RenderTarget& render_target) = 0;
 
+	/**
+	 * @brief Appends live counters shown by the performance HUD.
+	 *
+	 * @param counters[out] - Counter list to append to. Scenes without counters leave it untouched.
+	 */
+    virtual void get_hud_counters(std::vector<Hud_counter>& counters) const { (void)counters; }
+
 	/** @brief Returns the current type of the scene. */
     virtual FLEV_NODISCARD Game_state get_scene_type() const = 0;
 
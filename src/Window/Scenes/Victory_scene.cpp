@@ -21,44 +21,38 @@ Victory_scene::Victory_scene(Main_window& window, const int32_t level_id, const
     const auto panel_pos = panel_->get_bounds().position;
     const auto panel_size = panel_->get_bounds().size;
 
-    if (!font_.openFromFile("assets/timesnewromanpsmt.ttf"))
-    {
-        LOG_ERROR(
-            get_global_logger(),
-			"Failed to load font for victory scene"
-        );
-    }
+    font_ = get_resource_manager().get_font("assets/timesnewromanpsmt.ttf");
 
     // Title label
-    title_label_ = std::make_unique<Label>("Победа!", font_, 50);
+    title_label_ = std::make_unique<Label>("Победа!", *font_, 50);
     title_label_->set_color(sf::Color::Yellow);
 
 	// Result label
     const auto result_text = std::format("{} набрал {} очков", player_name_, score);
-    result_label_ = std::make_unique<Label>(result_text, font_, 32);
+    result_label_ = std::make_unique<Label>(result_text, *font_, 32);
     result_label_->set_color(sf::Color::White);
 
     // Buttons
     const sf::FloatRect button_rect = { { 0.f, 0.f }, { 180.f, 50.f } };
 
-    buttons_.emplace("menu", std::make_unique<Button>(
+    buttons_[Action::Menu] = std::make_unique<Button>(
         button_rect,
         "Выйти",
-        font_,
+        *font_,
         28u
-    ));
-    buttons_.emplace("restart", std::make_unique<Button>(
+    );
+    buttons_[Action::Restart] = std::make_unique<Button>(
         button_rect,
         "Ещё раз",
-        font_,
+        *font_,
         28u
-    ));
-    buttons_.emplace("next", std::make_unique<Button>(
+    );
+    buttons_[Action::Next] = std::make_unique<Button>(
         button_rect,
         "Следующий",
-        font_,
+        *font_,
         28u
-    ));
+    );
 
     // Positioning objects on the panel
     const auto panel_center = panel_->get_bounds().getCenter();
@@ -73,35 +67,38 @@ Victory_scene::Victory_scene(Main_window& window, const int32_t level_id, const
         panel_->get_bounds().position.y + 120.f
     });
 
-    buttons_["menu"]->set_position({ panel_center.x - button_rect.size.x - 100.f, button_y });
-    buttons_["restart"]->set_position({ panel_center.x - button_rect.size.x / 2.f, button_y });
-    buttons_["next"]->set_position({ panel_center.x + 100.f, button_y });
+    buttons_[Action::Menu]->set_position({ panel_center.x - button_rect.size.x - 100.f, button_y });
+    buttons_[Action::Restart]->set_position({ panel_center.x - button_rect.size.x / 2.f, button_y });
+    buttons_[Action::Next]->set_position({ panel_center.x + 100.f, button_y });
 
 	// Unlock next level
     if (!main_window_.unlock_next_level())
     {
-		buttons_.erase("next");
+		buttons_[Action::Next].reset();
     }
 }//!Victory_scene
 //---------------------------------------------------------------------------------------
 
 void Victory_scene::handle_event(const sf::Event& event)
 {
-    for (auto& [name, btn] : buttons_)
+    for (const auto action : enum_values<Action>())
     {
-        if (btn->handle_event(event))
+        const auto& btn = buttons_[action];
+        if (btn && btn->handle_event(event))
         {
-            if (name == "menu")
+            switch (action)
             {
+            case Action::Menu:
                 main_window_.switch_to(Game_state::Main_Menu);
-            }
-            else if (name == "restart")
-            {
+                break;
+            case Action::Restart:
                 main_window_.switch_to(Game_state::Game);
-            }
-            else if (name == "next")
-            {
+                break;
+            case Action::Next:
                 main_window_.switch_to_game(level_id_ + 1);
+                break;
+            default:
+                break;
             }
             break;
         }
@@ -119,13 +116,13 @@ void Victory_scene::handle_event(const sf::Event& event)
 
 void Victory_scene::draw(sf::RenderTarget& render_target)
 {
-    render_target.draw(overlay_);
+    draw_counted(render_target, overlay_);
     panel_->draw(render_target);
     title_label_->draw(render_target);
     result_label_->draw(render_target);
-    for (const auto& [_, btn] : buttons_)
+    for (const auto& btn : buttons_)
     {
-        btn->draw(render_target);
+        if (btn) btn->draw(render_target);
     }
 }//!draw
 //---------------------------------------------------------------------------------------
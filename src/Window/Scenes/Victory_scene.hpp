@@ -3,7 +3,7 @@
 #include <UI/Label.hpp>
 #include <UI/Panel.hpp>
 #include <UI/Button.hpp>
-#include <map>
+#include <utils/enum_array.hpp>
 
 class Victory_scene : public Scene
 {
@@ -28,17 +28,29 @@ public:
     /** @brief Returns Game_state::Victory. */
     FLEV_NODISCARD Game_state get_scene_type() const override;
 
-private:
+private/*types*/:
+
+    /** @brief Result screen button actions. */
+    enum class Action : uint8_t
+    {
+        Menu,
+        Restart,
+        Next, ///< Absent when there is no next level.
+
+        Count
+    };
+
+private/*vars*/:
 
     int32_t level_id_;                  ///< Completed level ID (used for "Next" button).
     int32_t score_;                     ///< Total score achieved on this level.
     std::string player_name_;           ///< Player name displayed in result message.
 
-    sf::Font font_;                         ///< Font for all text elements.
+    Font_handle font_;                      ///< Font for all text elements.
 
     sf::RectangleShape overlay_;            ///< Dimming layer (victory theme).
     std::unique_ptr<Panel> panel_;          ///< Central UI panel.
     std::unique_ptr<Label> title_label_;    ///< Static header.
     std::unique_ptr<Label> result_label_;   ///< Static message.
-    std::map<std::string, std::unique_ptr<Button>> buttons_; ///< Action buttons by name.
+    Enum_array<Action, std::unique_ptr<Button>> buttons_; ///< Action buttons (null if hidden).
 };
\ No newline at end of file
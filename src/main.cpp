@@ -1,8 +1,36 @@
 #include "Window/Main_window.hpp"
+#include <string_view>
+#include <charconv>
 
-int main()
+int main(int argc, char** argv)
 {
-    Main_window app;
+    // Optional "--tick-rate=<hz>" to tune simulation rate for the machine,
+    // "--record=<path>" / "--replay=<path>" to record or play back game runs
+    uint32_t tick_rate = 60u;
+    Replay_options replay_options;
+    for (int i = 1; i < argc; ++i)
+    {
+        constexpr std::string_view tick_rate_arg = "--tick-rate=";
+        constexpr std::string_view record_arg = "--record=";
+        constexpr std::string_view replay_arg = "--replay=";
+        const std::string_view arg = argv[i];
+        if (arg.starts_with(tick_rate_arg))
+        {
+            const auto value = arg.substr(tick_rate_arg.size());
+            std::from_chars(value.data(), value.data() + value.size(), tick_rate);
+        }
+        else if (arg.starts_with(record_arg))
+        {
+            replay_options.record_path = arg.substr(record_arg.size());
+        }
+        else if (arg.starts_with(replay_arg))
+        {
+            replay_options.playback_path = arg.substr(replay_arg.size());
+        }
+    }
+
+    Main_window app({ 1920u, 1080u }, tick_rate);
+    app.set_replay_options(replay_options);
     app.run();
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,90 @@
+#pragma once
+#include "defines.hpp"
+#include <memory_resource>
+#include <cstddef>
+
+/**
+ * @brief Memory for everything that lives as long as one level.
+ *
+ * Allocations are bump-allocated from large blocks and individual frees are
+ * no-ops; all blocks are returned at once when the arena is destroyed. Give
+ * get_resource() to std::pmr containers that are created with the level and
+ * grow to a steady size (entity columns, broadphase cells, ...).
+ *
+ * @note Containers using the arena must be destroyed before it.
+ */
+class Level_arena
+{
+public:
+
+    /**
+     * @brief Constructs an empty arena (no memory is taken until the first allocation).
+     *
+     * @param initial_block_size[in][opt] - Size of the first block; later blocks grow geometrically. [Default: 256 KiB]
+     */
+    explicit Level_arena(const size_t initial_block_size = 256u * 1024u)
+        : resource_(initial_block_size, std::pmr::new_delete_resource())
+    {
+    }//!Level_arena
+
+    Level_arena(const Level_arena&) = delete;
+    Level_arena& operator=(const Level_arena&) = delete;
+
+    /** @returns Memory resource of the arena. */
+    FLEV_NODISCARD std::pmr::memory_resource* get_resource() { return &resource_; }
+
+private:
+
+    std::pmr::monotonic_buffer_resource resource_; ///< Block allocator.
+};
+
+/**
+ * @brief Linear scratch memory for data that lives at most one tick.
+ *
+ * Allocations bump a pointer through a fixed buffer; reset() rewinds it.
+ * When a tick needs more than the buffer holds, the overflow comes from the
+ * heap and is freed by the next reset().
+ *
+ * @note Nothing allocated from the arena may be used after reset().
+ */
+class Scratch_arena
+{
+public:
+
+    /**
+     * @brief Allocates the scratch buffer.
+     *
+     * @param capacity[in]        - Buffer size in bytes.
+     * @param upstream[in][opt]   - Where the buffer itself is allocated (e.g. a level arena). [Default: heap]
+     */
+    explicit Scratch_arena(const size_t capacity, std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+        : upstream_(upstream)
+        , capacity_(capacity)
+        , buffer_(upstream->allocate(capacity, alignof(std::max_align_t)))
+        , resource_(buffer_, capacity, std::pmr::new_delete_resource())
+    {
+    }//!Scratch_arena
+
+    /** @brief Returns the buffer to its upstream resource. */
+    ~Scratch_arena() noexcept
+    {
+        resource_.release();
+        upstream_->deallocate(buffer_, capacity_, alignof(std::max_align_t));
+    }//!~Scratch_arena
+
+    Scratch_arena(const Scratch_arena&) = delete;
+    Scratch_arena& operator=(const Scratch_arena&) = delete;
+
+    /** @returns Memory resource of the arena. */
+    FLEV_NODISCARD std::pmr::memory_resource* get_resource() { return &resource_; }
+
+    /** @brief Frees everything allocated since the last reset. */
+    void reset() { resource_.release(); }
+
+private:
+
+    std::pmr::memory_resource* upstream_;          ///< Owner of buffer_.
+    size_t capacity_;                              ///< Size of buffer_ in bytes.
+    void* buffer_;                                 ///< Scratch buffer.
+    std::pmr::monotonic_buffer_resource resource_; ///< Bump allocator over buffer_ (heap overflow).
+};
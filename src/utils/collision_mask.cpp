@@ -0,0 +1,199 @@
+#include "collision_mask.hpp"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+Collision_mask::Collision_mask(const sf::Image& image, const sf::IntRect& area, const uint8_t alpha_threshold)
+{
+    const auto image_size = sf::Vector2i(image.getSize());
+    sf::IntRect source = (area.size.x > 0 && area.size.y > 0) ? area : sf::IntRect({}, image_size);
+    const auto clipped = source.findIntersection(sf::IntRect({}, image_size));
+    if (!clipped) return;
+    source = *clipped;
+
+    resize(static_cast<uint32_t>(source.size.x), static_cast<uint32_t>(source.size.y));
+    const uint8_t* pixels = image.getPixelsPtr();
+    const size_t stride = static_cast<size_t>(image_size.x) * 4u;
+    for (uint32_t y = 0; y < height_; ++y)
+    {
+        const uint8_t* row = pixels + (source.position.y + y) * stride + source.position.x * 4u;
+        for (uint32_t x = 0; x < width_; ++x)
+        {
+            if (row[x * 4u + 3u] >= alpha_threshold) set(x, y);
+        }
+    }
+    update_solid_area();
+}//!Collision_mask
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD Collision_mask Collision_mask::scaled(const sf::Vector2f& scale) const
+{
+    Collision_mask result;
+    if (empty()) return result;
+
+    const auto new_width = static_cast<uint32_t>(std::max(1.f, std::round(width_ * std::abs(scale.x))));
+    const auto new_height = static_cast<uint32_t>(std::max(1.f, std::round(height_ * std::abs(scale.y))));
+    result.resize(new_width, new_height);
+
+    std::vector<uint64_t> merged(words_per_row_);
+    for (uint32_t y = 0; y < new_height; ++y)
+    {
+        // Source rows covered by this target row, merged into one
+        const auto src_y_begin = static_cast<uint32_t>(uint64_t{ y } * height_ / new_height);
+        const auto src_y_end = static_cast<uint32_t>((uint64_t{ y + 1u } * height_ + new_height - 1u) / new_height);
+        std::fill(merged.begin(), merged.end(), 0u);
+        for (uint32_t src_y = src_y_begin; src_y < src_y_end; ++src_y)
+        {
+            const uint64_t* row = &bits_[static_cast<size_t>(src_y) * words_per_row_];
+            for (uint32_t w = 0; w < words_per_row_; ++w) merged[w] |= row[w];
+        }
+
+        for (uint32_t x = 0; x < new_width; ++x)
+        {
+            // Solid if any merged bit in [src_x_begin, src_x_end) is set
+            const auto src_x_begin = static_cast<uint32_t>(uint64_t{ x } * width_ / new_width);
+            const auto src_x_end = static_cast<uint32_t>((uint64_t{ x + 1u } * width_ + new_width - 1u) / new_width);
+            for (uint32_t src_x = src_x_begin; src_x < src_x_end; src_x += 64u)
+            {
+                const uint32_t word = src_x >> 6u;
+                const uint32_t shift = src_x & 63u;
+                const uint32_t count = std::min(64u - shift, src_x_end - src_x);
+                const uint64_t range = (count == 64u ? ~uint64_t{ 0 } : ((uint64_t{ 1 } << count) - 1u)) << shift;
+                if (merged[word] & range)
+                {
+                    result.set(x, y);
+                    break;
+                }
+                src_x -= shift; // Continue from the next word boundary
+            }
+        }
+    }
+    result.update_solid_area();
+    return result;
+}//!scaled
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD Collision_mask Collision_mask::rotated_180() const
+{
+    Collision_mask result;
+    if (empty()) return result;
+
+    result.resize(width_, height_);
+    for (uint32_t y = 0; y < height_; ++y)
+    {
+        for (uint32_t x = 0; x < width_; ++x)
+        {
+            if (test(static_cast<int32_t>(x), static_cast<int32_t>(y))) result.set(width_ - 1u - x, height_ - 1u - y);
+        }
+    }
+    result.update_solid_area();
+    return result;
+}//!rotated_180
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD bool Collision_mask::empty() const
+{
+    return width_ == 0u || height_ == 0u;
+}//!empty
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD sf::Vector2u Collision_mask::get_size() const
+{
+    return { width_, height_ };
+}//!get_size
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD const sf::IntRect& Collision_mask::get_solid_area() const
+{
+    return solid_area_;
+}//!get_solid_area
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD bool Collision_mask::test(const int32_t x, const int32_t y) const
+{
+    if (x < 0 || y < 0 || x >= static_cast<int32_t>(width_) || y >= static_cast<int32_t>(height_)) return false;
+    return (get_bits(static_cast<uint32_t>(x), static_cast<uint32_t>(y)) & 1u) != 0u;
+}//!test
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD bool Collision_mask::overlaps(
+    const Collision_mask& a, const sf::Vector2i& a_position,
+    const Collision_mask& b, const sf::Vector2i& b_position
+)
+{
+    // Work in a's pixel space; only the overlap of both solid areas can hit
+    const sf::Vector2i offset = b_position - a_position;
+    const auto& a_area = a.solid_area_;
+    const auto& b_area = b.solid_area_;
+    const int32_t x_begin = std::max(a_area.position.x, b_area.position.x + offset.x);
+    const int32_t x_end = std::min(a_area.position.x + a_area.size.x, b_area.position.x + b_area.size.x + offset.x);
+    const int32_t y_begin = std::max(a_area.position.y, b_area.position.y + offset.y);
+    const int32_t y_end = std::min(a_area.position.y + a_area.size.y, b_area.position.y + b_area.size.y + offset.y);
+    if (x_begin >= x_end || y_begin >= y_end) return false;
+
+    // Bits past either solid area are zero, so whole words can be ANDed without masking
+    for (int32_t y = y_begin; y < y_end; ++y)
+    {
+        const auto a_y = static_cast<uint32_t>(y);
+        const auto b_y = static_cast<uint32_t>(y - offset.y);
+        for (int32_t x = x_begin; x < x_end; x += 64)
+        {
+            if (a.get_bits(static_cast<uint32_t>(x), a_y) & b.get_bits(static_cast<uint32_t>(x - offset.x), b_y))
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}//!overlaps
+//---------------------------------------------------------------------------------------
+
+void Collision_mask::resize(const uint32_t width, const uint32_t height)
+{
+    width_ = width;
+    height_ = height;
+    words_per_row_ = (width + 63u) / 64u;
+    bits_.assign(static_cast<size_t>(words_per_row_) * height_, 0u);
+    solid_area_ = {};
+}//!resize
+//---------------------------------------------------------------------------------------
+
+void Collision_mask::set(const uint32_t x, const uint32_t y)
+{
+    bits_[static_cast<size_t>(y) * words_per_row_ + (x >> 6u)] |= uint64_t{ 1 } << (x & 63u);
+}//!set
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD uint64_t Collision_mask::get_bits(const uint32_t x, const uint32_t y) const
+{
+    const uint32_t word = x >> 6u;
+    const uint32_t shift = x & 63u;
+    if (word >= words_per_row_) return 0u;
+
+    const uint64_t* row = &bits_[static_cast<size_t>(y) * words_per_row_];
+    uint64_t bits = row[word] >> shift;
+    if (shift != 0u && word + 1u < words_per_row_) bits |= row[word + 1u] << (64u - shift);
+    return bits;
+}//!get_bits
+//---------------------------------------------------------------------------------------
+
+void Collision_mask::update_solid_area()
+{
+    int32_t min_x = static_cast<int32_t>(width_), min_y = static_cast<int32_t>(height_);
+    int32_t max_x = -1, max_y = -1;
+    for (uint32_t y = 0; y < height_; ++y)
+    {
+        const uint64_t* row = &bits_[static_cast<size_t>(y) * words_per_row_];
+        for (uint32_t w = 0; w < words_per_row_; ++w)
+        {
+            if (row[w] == 0u) continue;
+            const auto base = static_cast<int32_t>(w * 64u);
+            min_x = std::min(min_x, base + std::countr_zero(row[w]));
+            max_x = std::max(max_x, base + 63 - std::countl_zero(row[w]));
+            min_y = std::min(min_y, static_cast<int32_t>(y));
+            max_y = static_cast<int32_t>(y);
+        }
+    }
+    solid_area_ = (max_x < 0) ? sf::IntRect{} : sf::IntRect({ min_x, min_y }, { max_x - min_x + 1, max_y - min_y + 1 });
+}//!update_solid_area
+//---------------------------------------------------------------------------------------
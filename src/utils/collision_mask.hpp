@@ -0,0 +1,94 @@
+#pragma once
+#include "defines.hpp"
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include <cstdint>
+
+/**
+ * @brief Per-pixel collision shape of a sprite, packed into 64-bit row bitsets.
+ *
+ * Built once per texture from the alpha channel, then scaled to the sprite
+ * scale. Bit k of word w in a row is pixel x = w * 64 + k; padding bits past
+ * the width are always zero. Overlap tests AND whole words of both masks, so
+ * a 64 pixel wide sprite costs one AND per overlapping row.
+ */
+class Collision_mask
+{
+public:
+
+    /** @brief Constructs an empty mask (collides nowhere, see empty()). */
+    Collision_mask() = default;
+
+    /**
+     * @brief Builds a mask from the alpha channel of an image area.
+     *
+     * @param image[in]               - Source image.
+     * @param area[in][opt]           - Pixel area of the image to use (empty rect uses the whole image). [Default: {}]
+     * @param alpha_threshold[in][opt] - Pixels with alpha at or above this value are solid. [Default: 128]
+     */
+    explicit Collision_mask(const sf::Image& image, const sf::IntRect& area = {}, const uint8_t alpha_threshold = 128u);
+
+    /**
+     * @brief Resamples the mask to sprite scale.
+     *
+     * A target pixel is solid if any source pixel it covers is solid, so thin
+     * details survive downscaling.
+     *
+     * @param scale[in] - Sprite scale (same value as passed to sf::Sprite::setScale).
+     *
+     * @returns Scaled mask (at least 1x1 pixel unless this mask is empty).
+     */
+    FLEV_NODISCARD Collision_mask scaled(const sf::Vector2f& scale) const;
+
+    /** @returns Mask of the sprite rotated by 180 degrees about its center. */
+    FLEV_NODISCARD Collision_mask rotated_180() const;
+
+    /** @returns true if the mask holds no pixels. */
+    FLEV_NODISCARD bool empty() const;
+
+    /** @returns Mask size in pixels. */
+    FLEV_NODISCARD sf::Vector2u get_size() const;
+
+    /** @returns Smallest pixel rectangle holding every solid pixel (empty if there are none). */
+    FLEV_NODISCARD const sf::IntRect& get_solid_area() const;
+
+    /** @returns true if pixel (x, y) is solid (out-of-range pixels are not). */
+    FLEV_NODISCARD bool test(const int32_t x, const int32_t y) const;
+
+    /**
+     * @brief Tests two placed masks for a shared solid pixel.
+     *
+     * @param a[in]          - First mask.
+     * @param a_position[in] - World pixel of the top-left corner of a.
+     * @param b[in]          - Second mask.
+     * @param b_position[in] - World pixel of the top-left corner of b.
+     *
+     * @returns true if at least one pixel is solid in both masks.
+     */
+    FLEV_NODISCARD static bool overlaps(
+        const Collision_mask& a, const sf::Vector2i& a_position,
+        const Collision_mask& b, const sf::Vector2i& b_position
+    );
+
+private/*methods*/:
+
+    /** @brief Allocates zeroed rows for the given size. */
+    void resize(const uint32_t width, const uint32_t height);
+
+    /** @brief Marks pixel (x, y) as solid. */
+    void set(const uint32_t x, const uint32_t y);
+
+    /** @returns 64 pixels of row y starting at pixel x (pixels past the row are zero). */
+    FLEV_NODISCARD uint64_t get_bits(const uint32_t x, const uint32_t y) const;
+
+    /** @brief Recomputes solid_area_ from the bits. */
+    void update_solid_area();
+
+private/*vars*/:
+
+    uint32_t width_ = 0u;          ///< Width in pixels.
+    uint32_t height_ = 0u;         ///< Height in pixels.
+    uint32_t words_per_row_ = 0u;  ///< 64-bit words per row.
+    std::vector<uint64_t> bits_;   ///< Rows of words_per_row_ words each.
+    sf::IntRect solid_area_;       ///< Bounds of the solid pixels.
+};
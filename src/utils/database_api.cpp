@@ -29,7 +29,10 @@ Database::Database(const std::string& db_name, int32_t flags)
 Database::~Database()
 {
 	if (!db_) return;
-	
+
+	// Cached statements keep the connection busy, finalize them first
+	trim_statement_cache(0u);
+
 	const auto result = sqlite3_close(db_);
 	if (result != SQLITE_OK)
 	{
@@ -86,10 +89,7 @@ FLEV_NODISCARD bool Database::execute_query(const std::string& query)
 }//!execute_query
 //---------------------------------------------------------------------------------------
 
-FLEV_NODISCARD bool Database::execute_prepared(
-	const std::string& sql_with_braces,
-	const std::vector<std::variant<int32_t, std::string>>& params
-)
+FLEV_NODISCARD bool Database::execute_prepared(const std::string& sql_with_braces, const Param_array& params)
 {
 	if (!db_) return false;
 	if (sql_with_braces.empty())
@@ -103,33 +103,115 @@ FLEV_NODISCARD bool Database::execute_prepared(
 		return execute_query(sql_with_braces);
 	}
 
+	std::lock_guard lock(M_exec_);
+
+	// 1-2. Prepare statement (or reuse the cached one) and bind parameters
+	bool cached = false;
+	sqlite3_stmt* stmt = prepare_bound(sql_with_braces, params, cached);
+	if (!stmt) return false;
+
+	// 3. Execute statement
+	const auto rc = sqlite3_step(stmt);
+	if (rc != SQLITE_DONE)
+	{
+		LOG_ERROR(
+			logger,
+			"Failed to execute prepared statement: {}. Error: [{}] {}",
+			sql_with_braces,
+			rc,
+			sqlite3_errmsg(db_)
+		);
+		release_statement(stmt, cached);
+		return false;
+	}
+
+	release_statement(stmt, cached);
+	return true;
+}//!execute_prepared
+//---------------------------------------------------------------------------------------
+
+void Database::set_statement_cache_capacity(const size_t capacity)
+{
+	std::lock_guard lock(M_exec_);
+	statement_capacity_ = capacity;
+	trim_statement_cache(capacity);
+}//!set_statement_cache_capacity
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD Database::Statement_cache_stats Database::get_statement_cache_stats()
+{
+	std::lock_guard lock(M_exec_);
+	auto stats = statement_stats_;
+	stats.size = statements_.size();
+	return stats;
+}//!get_statement_cache_stats
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD Database::Cols_array Database::get_cols()
+{
+	std::lock_guard lock(M_exec_);
+	return cols_;
+}//!get_cols
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD Database::Rows_array Database::get_rows()
+{
+	std::lock_guard lock(M_exec_);
+	return rows_;
+}//!get_rows
+//---------------------------------------------------------------------------------------
+
+int32_t Database::query_callback(void* self_ptr, int32_t argc, char** argv, char** col_names)
+{
+	auto self = static_cast<Database*>(self_ptr);
+	if (!self) return 1;
+
+	// Get columns only at first call per query
+	if (self->rows_.empty())
+	{
+		self->cols_.clear();
+		for (int32_t i = 0; i < argc; ++i)
+		{
+			self->cols_.emplace_back(col_names[i]);
+		}
+	}
+
+	Row_array row;
+	for (int32_t i = 0; i < argc; ++i)
+	{
+		row.push_back(argv[i] ? argv[i] : "NULL");
+	}
+	self->rows_.push_back(std::move(row));
+
+	return 0;
+}//!query_callback
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD sqlite3_stmt* Database::acquire_statement(const std::string& sql_with_braces, bool& cached)
+{
+	cached = false;
+	if (const auto it = statement_index_.find(sql_with_braces); it != statement_index_.end())
+	{
+		// Hit: move to the front of the LRU list
+		statements_.splice(statements_.begin(), statements_, it->second);
+		++statement_stats_.hits;
+		cached = true;
+		return it->second->stmt;
+	}
+	++statement_stats_.misses;
+
 	// Replace {} with ? for SQLite
 	std::string sql = sql_with_braces;
 	size_t pos = 0;
-	int32_t brace_count = 0;
 	while ((pos = sql.find("{}", pos)) != std::string::npos)
 	{
 		sql.replace(pos, 2, "?");
 		pos += 1; // Skip '?'
-		brace_count++;
-	}
-
-	if (brace_count != static_cast<int32_t>(params.size()))
-	{
-		LOG_ERROR(
-			logger, 
-			"Parameter count mismatch: {} placeholders, {} params",
-			brace_count, 
-			params.size()
-		);
-		return false;
 	}
 
 	sqlite3_stmt* stmt = nullptr;
 	const char* tail = nullptr;
-
-	// 1. Prepare statement
-	auto rc = sqlite3_prepare_v2(db_, sql.c_str(), -1, &stmt, &tail);
+	const auto rc = sqlite3_prepare_v2(db_, sql.c_str(), -1, &stmt, &tail);
 	if (rc != SQLITE_OK)
 	{
 		LOG_ERROR(
@@ -139,13 +221,80 @@ FLEV_NODISCARD bool Database::execute_prepared(
 			rc,
 			sqlite3_errmsg(db_)
 		);
-		return false;
+		sqlite3_finalize(stmt);
+		return nullptr;
+	}
+	if (statement_capacity_ == 0u) return stmt;
+
+	// Make room first, the new statement must not be evicted
+	trim_statement_cache(statement_capacity_ - 1u);
+	statements_.push_front({ sql_with_braces, stmt });
+	statement_index_.emplace(statements_.front().sql, statements_.begin());
+	cached = true;
+	return stmt;
+}//!acquire_statement
+//---------------------------------------------------------------------------------------
+
+void Database::trim_statement_cache(const size_t capacity)
+{
+	while (statements_.size() > capacity)
+	{
+		auto& oldest = statements_.back();
+		statement_index_.erase(oldest.sql);
+		sqlite3_finalize(oldest.stmt);
+		statements_.pop_back();
+		++statement_stats_.evictions;
 	}
+}//!trim_statement_cache
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD sqlite3_stmt* Database::prepare_bound(const std::string& sql_with_braces, const Param_array& params, bool& cached)
+{
+	sqlite3_stmt* stmt = acquire_statement(sql_with_braces, cached);
+	if (!stmt) return nullptr;
 
-	// 2. Bind parameters
+	const auto placeholder_count = sqlite3_bind_parameter_count(stmt);
+	if (placeholder_count != static_cast<int32_t>(params.size()))
+	{
+		LOG_ERROR(
+			logger, 
+			"Parameter count mismatch: {} placeholders, {} params",
+			placeholder_count, 
+			params.size()
+		);
+		release_statement(stmt, cached);
+		return nullptr;
+	}
+	if (!bind_params(stmt, params))
+	{
+		release_statement(stmt, cached);
+		return nullptr;
+	}
+	return stmt;
+}//!prepare_bound
+//---------------------------------------------------------------------------------------
+
+void Database::release_statement(sqlite3_stmt* stmt, const bool cached)
+{
+	// Cached statements go back to the cache reset and unbound, others are finalized
+	if (cached)
+	{
+		sqlite3_reset(stmt);
+		sqlite3_clear_bindings(stmt);
+	}
+	else
+	{
+		sqlite3_finalize(stmt);
+	}
+}//!release_statement
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD bool Database::bind_params(sqlite3_stmt* stmt, const Param_array& params)
+{
 	for (size_t i = 0; i < params.size(); i++)
 	{
 		auto idx = static_cast<int32_t>(i + 1); // SQLite: 1-based!
+		int32_t rc = SQLITE_OK;
 
 		if (std::holds_alternative<int32_t>(params[i]))
 		{
@@ -172,67 +321,61 @@ FLEV_NODISCARD bool Database::execute_prepared(
 				rc,
 				sqlite3_errmsg(db_)
 			);
-			sqlite3_finalize(stmt);
 			return false;
 		}
 	}
-
-	// 3. Execute statement
-	rc = sqlite3_step(stmt);
-	if (rc != SQLITE_DONE)
-	{
-		LOG_ERROR(
-			logger,
-			"Failed to execute prepared statement: {}. Error: [{}] {}",
-			sql,
-			rc,
-			sqlite3_errmsg(db_)
-		);
-		sqlite3_finalize(stmt);
-		return false;
-	}
-
-	sqlite3_finalize(stmt);
 	return true;
-}//!execute_prepared
+}//!bind_params
 //---------------------------------------------------------------------------------------
 
-FLEV_NODISCARD Database::Cols_array Database::get_cols()
+FLEV_NODISCARD bool Database::run_query(
+	const std::string& sql_with_braces,
+	const Param_array& params,
+	void* context,
+	const Row_visitor visitor
+)
 {
-	std::lock_guard lock(M_exec_);
-	return cols_;
-}//!get_cols
-//---------------------------------------------------------------------------------------
+	if (!db_)
+	{
+		LOG_ERROR(logger, "Database handle is null. Cannot execute query.");
+		return false;
+	}
+	if (sql_with_braces.empty())
+	{
+		LOG_ERROR(logger, "Cannot execute empty query.");
+		return false;
+	}
 
-FLEV_NODISCARD Database::Rows_array Database::get_rows()
-{
 	std::lock_guard lock(M_exec_);
-	return rows_;
-}//!get_rows
-//---------------------------------------------------------------------------------------
 
-int32_t Database::query_callback(void* self_ptr, int32_t argc, char** argv, char** col_names)
-{
-	auto self = static_cast<Database*>(self_ptr);
-	if (!self) return 1;
+	bool cached = false;
+	sqlite3_stmt* stmt = prepare_bound(sql_with_braces, params, cached);
+	if (!stmt) return false;
 
-	// Get columns only at first call per query
-	if (self->rows_.empty())
+	const Row_view row(stmt);
+	int32_t rc = SQLITE_ROW;
+	while ((rc = sqlite3_step(stmt)) == SQLITE_ROW)
 	{
-		self->cols_.clear();
-		for (int32_t i = 0; i < argc; ++i)
+		if (!visitor(context, row))
 		{
-			self->cols_.emplace_back(col_names[i]);
+			rc = SQLITE_DONE; // Stopped by the visitor
+			break;
 		}
 	}
-
-	Row_array row;
-	for (int32_t i = 0; i < argc; ++i)
+	if (rc != SQLITE_DONE)
 	{
-		row.push_back(argv[i] ? argv[i] : "NULL");
+		LOG_ERROR(
+			logger,
+			"SQL error while stepping query: '{}'. Error: [{}] {}",
+			sql_with_braces,
+			rc,
+			sqlite3_errmsg(db_)
+		);
+		release_statement(stmt, cached);
+		return false;
 	}
-	self->rows_.push_back(std::move(row));
 
-	return 0;
-}//!query_callback
-//---------------------------------------------------------------------------------------
\ No newline at end of file
+	release_statement(stmt, cached);
+	return true;
+}//!run_query
+//---------------------------------------------------------------------------------------
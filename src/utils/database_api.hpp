@@ -3,6 +3,16 @@
 #include "logger.hpp"
 #include <sqlite3.h>
 #include <variant>
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
 
 class Database
 {
@@ -11,6 +21,73 @@ public:
 	using Cols_array = std::vector<std::string>;
 	using Row_array  = std::vector<std::string>;
 	using Rows_array = std::vector<Row_array>;
+	using Param      = std::variant<int32_t, std::string>;
+	using Param_array = std::vector<Param>;
+
+	/**
+	 * @brief Typed read access to the current row of a running query.
+	 *
+	 * Values come straight from SQLite: text and blob views stay valid only
+	 * until the visitor returns, copy them to keep them.
+	 */
+	class Row_view
+	{
+	public:
+
+		/** @return Number of columns in the result. */
+		FLEV_NODISCARD int32_t get_column_count() const { return sqlite3_column_count(stmt_); }
+
+		/** @return Name of the column (as written in the SELECT list). */
+		FLEV_NODISCARD std::string_view get_column_name(const int32_t col) const
+		{
+			const char* name = sqlite3_column_name(stmt_, col);
+			return name ? std::string_view(name) : std::string_view{};
+		}//!get_column_name
+
+		/** @return true if the value is NULL. */
+		FLEV_NODISCARD bool is_null(const int32_t col) const { return sqlite3_column_type(stmt_, col) == SQLITE_NULL; }
+
+		/** @return Value as a 64-bit integer (NULL reads as 0). */
+		FLEV_NODISCARD int64_t get_int64(const int32_t col) const { return sqlite3_column_int64(stmt_, col); }
+
+		/** @return Value as a double (NULL reads as 0). */
+		FLEV_NODISCARD double get_double(const int32_t col) const { return sqlite3_column_double(stmt_, col); }
+
+		/** @return Value as UTF-8 text (NULL reads as empty). */
+		FLEV_NODISCARD std::string_view get_text(const int32_t col) const
+		{
+			const auto* text = reinterpret_cast<const char*>(sqlite3_column_text(stmt_, col));
+			if (!text) return {};
+			return { text, static_cast<size_t>(sqlite3_column_bytes(stmt_, col)) };
+		}//!get_text
+
+		/** @return Value as raw bytes (NULL reads as empty). */
+		FLEV_NODISCARD std::span<const std::byte> get_blob(const int32_t col) const
+		{
+			const auto* data = static_cast<const std::byte*>(sqlite3_column_blob(stmt_, col));
+			if (!data) return {};
+			return { data, static_cast<size_t>(sqlite3_column_bytes(stmt_, col)) };
+		}//!get_blob
+
+	private:
+
+		friend class Database;
+		explicit Row_view(sqlite3_stmt* stmt) : stmt_(stmt) {}
+
+		sqlite3_stmt* stmt_ = nullptr; ///< Statement positioned on the row.
+	};
+
+	/** @brief Prepared statement cache counters (since the database was opened). */
+	struct Statement_cache_stats
+	{
+		uint64_t hits = 0u;      ///< execute_prepared() calls that reused a cached statement.
+		uint64_t misses = 0u;    ///< execute_prepared() calls that had to compile the SQL.
+		uint64_t evictions = 0u; ///< Statements finalized to make room for newer ones.
+		size_t size = 0u;        ///< Statements currently cached.
+	};
+
+	/** @brief Statements kept compiled by default (distinct SQL texts). */
+	static constexpr size_t default_statement_cache_capacity = 16u;
 
 	/** 
 	 * @brief Constructor.
@@ -54,15 +131,58 @@ public:
 	 *
 	 * Example: execute_prepared("INSERT INTO t (a, b) VALUES ({}, {})", {42, "hello"});
 	 *
+	 * Compiled statements are cached by their SQL text (least recently used
+	 * ones are finalized first), so repeating a query only rebinds and steps.
+	 *
 	 * @param sql[in]    - SQL query with {} placeholders.
 	 * @param params[in] - Parameters to bind (int, std::string).
 	 *
 	 * @return true on success, false on error.
 	 */
-	FLEV_NODISCARD bool execute_prepared(
-		const std::string& sql,
-		const std::vector<std::variant<int32_t, std::string>>& params
-	);
+	FLEV_NODISCARD bool execute_prepared(const std::string& sql, const Param_array& params);
+
+	/**
+	 * @brief Runs a SELECT and hands every row to the visitor as it is stepped.
+	 *
+	 * Nothing is materialized: the visitor reads typed columns from a
+	 * Row_view. Uses the prepared statement cache like execute_prepared().
+	 *
+	 * Example:
+	 *     db.for_each_row("SELECT name, score FROM t WHERE level = {}", { 1 }, [&](const Database::Row_view& row) {
+	 *         use(row.get_text(0), row.get_int64(1));
+	 *     });
+	 *
+	 * @param sql[in]     - SQL with {} placeholders.
+	 * @param params[in]  - Parameters to bind (may be empty).
+	 * @param visitor[in] - Called per row; may return bool (false stops early). Must not use this Database.
+	 *
+	 * @return true if the query ran to the end (or the visitor stopped it), false on error.
+	 */
+	template <typename F>
+	FLEV_NODISCARD bool for_each_row(const std::string& sql, const Param_array& params, F&& visitor)
+	{
+		using Fn = std::remove_reference_t<F>;
+		void* context = const_cast<void*>(static_cast<const void*>(std::addressof(visitor)));
+		return run_query(sql, params, context, [](void* context, const Row_view& row) -> bool {
+			auto& fn = *static_cast<Fn*>(context);
+			if constexpr (std::is_convertible_v<std::invoke_result_t<Fn&, const Row_view&>, bool>) return fn(row);
+			else
+			{
+				fn(row);
+				return true;
+			}
+		});
+	}//!for_each_row
+
+	/**
+	 * @brief Sets how many compiled statements execute_prepared() keeps.
+	 *
+	 * @param capacity[in] - Maximum cached statements (0 compiles and finalizes every call).
+	 */
+	void set_statement_cache_capacity(const size_t capacity);
+
+	/** @return Prepared statement cache counters. */
+	FLEV_NODISCARD Statement_cache_stats get_statement_cache_stats();
 
 	/** @return Query result columns. */
 	FLEV_NODISCARD Cols_array get_cols();
@@ -70,8 +190,53 @@ public:
 	/** @return Query result rows. */
 	FLEV_NODISCARD Rows_array get_rows();
 
+private/*types*/:
+
+	/** @brief Compiled statement and the SQL it was requested with. */
+	struct Cached_statement
+	{
+		std::string sql;              ///< SQL with {} placeholders (cache key).
+		sqlite3_stmt* stmt = nullptr; ///< Compiled statement.
+	};
+
+	using Statement_list = std::list<Cached_statement>;
+	using Row_visitor = bool(*)(void* context, const Row_view& row);
+
 private/*methods*/:
 
+	/**
+	 * @brief Returns a compiled statement for the SQL, from the cache if possible.
+	 *
+	 * @param sql_with_braces[in] - SQL with {} placeholders.
+	 * @param cached[out]         - true if the statement is owned by the cache (reset it after use, do not finalize).
+	 *
+	 * @return Statement ready for binding, nullptr on compile error.
+	 *
+	 * @note Requires M_exec_ to be held.
+	 */
+	FLEV_NODISCARD sqlite3_stmt* acquire_statement(const std::string& sql_with_braces, bool& cached);
+
+	/** @brief Finalizes least recently used statements until at most capacity remain. Requires M_exec_. */
+	void trim_statement_cache(const size_t capacity);
+
+	/**
+	 * @brief Acquires the statement for the SQL and binds the parameters.
+	 *
+	 * @param cached[out] - Ownership flag for release_statement().
+	 *
+	 * @return Statement ready to step, nullptr on error (already released). Requires M_exec_.
+	 */
+	FLEV_NODISCARD sqlite3_stmt* prepare_bound(const std::string& sql_with_braces, const Param_array& params, bool& cached);
+
+	/** @brief Resets and unbinds a cached statement, finalizes an uncached one. */
+	void release_statement(sqlite3_stmt* stmt, const bool cached);
+
+	/** @return true if every parameter was bound to the statement. Requires M_exec_. */
+	FLEV_NODISCARD bool bind_params(sqlite3_stmt* stmt, const Param_array& params);
+
+	/** @brief Non-template body of for_each_row(). */
+	FLEV_NODISCARD bool run_query(const std::string& sql, const Param_array& params, void* context, const Row_visitor visitor);
+
 	/** 
 	 * @brief SQLite query callback function.
 	 * 
@@ -95,4 +260,10 @@ private/*vars*/:
 	std::mutex M_exec_;			 ///< Mutex for query execution.
 	Rows_array rows_;			 ///< Query result rows.
 	Cols_array cols_;			 ///< Query result columns.
+
+	// Prepared statement cache (guarded by M_exec_)
+	Statement_list statements_;	 ///< Cached statements, most recently used first.
+	std::unordered_map<std::string_view, Statement_list::iterator> statement_index_; ///< SQL -> node (keys view into node sql).
+	size_t statement_capacity_ = default_statement_cache_capacity; ///< Maximum cached statements.
+	Statement_cache_stats statement_stats_; ///< Hit/miss/eviction counters.
 };
\ No newline at end of file
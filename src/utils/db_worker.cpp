@@ -0,0 +1,144 @@
+#include "db_worker.hpp"
+#include "profiler.hpp"
+
+Db_worker::Db_worker(Database& db)
+    : db_(db)
+{
+    thread_ = std::thread([this] { run(); });
+}//!Db_worker
+//---------------------------------------------------------------------------------------
+
+Db_worker::~Db_worker() noexcept
+{
+    auto* stop = new Request();
+    stop->stop = true;
+    push(stop);
+    thread_.join();
+}//!~Db_worker
+//---------------------------------------------------------------------------------------
+
+void Db_worker::submit(std::string sql, Database::Param_array params)
+{
+    auto* request = new Request();
+    request->sql = std::move(sql);
+    request->params = std::move(params);
+    push(request);
+}//!submit
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD std::future<bool> Db_worker::submit_with_result(std::string sql, Database::Param_array params)
+{
+    auto* request = new Request();
+    request->sql = std::move(sql);
+    request->params = std::move(params);
+    auto future = request->result.emplace().get_future();
+    push(request);
+    return future;
+}//!submit_with_result
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD std::future<bool> Db_worker::flush()
+{
+    auto* request = new Request();
+    auto future = request->result.emplace().get_future();
+    push(request);
+    return future;
+}//!flush
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD uint64_t Db_worker::get_batch_count() const
+{
+    return batch_count_.load(std::memory_order_relaxed);
+}//!get_batch_count
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD uint64_t Db_worker::get_write_count() const
+{
+    return write_count_.load(std::memory_order_relaxed);
+}//!get_write_count
+//---------------------------------------------------------------------------------------
+
+void Db_worker::push(Request* request)
+{
+    request->next = head_.load(std::memory_order_relaxed);
+    while (!head_.compare_exchange_weak(request->next, request, std::memory_order_release, std::memory_order_relaxed))
+    {
+        // request->next was refreshed with the current head, retry
+    }
+    head_.notify_one();
+}//!push
+//---------------------------------------------------------------------------------------
+
+void Db_worker::run()
+{
+    FLEV_PROFILE_THREAD("db worker");
+    bool stopping = false;
+    while (!stopping)
+    {
+        head_.wait(nullptr, std::memory_order_acquire);
+
+        // The whole stack is taken at once, so popped nodes are never reused by producers (no ABA)
+        Request* batch = head_.exchange(nullptr, std::memory_order_acquire);
+        if (batch) stopping = execute_batch(batch);
+    }
+
+    // Writes that raced with the stop marker
+    if (Request* rest = head_.exchange(nullptr, std::memory_order_acquire)) (void)execute_batch(rest);
+}//!run
+//---------------------------------------------------------------------------------------
+
+bool Db_worker::execute_batch(Request* batch)
+{
+    FLEV_PROFILE_FUNCTION();
+
+    // Reverse the stack into submission order
+    Request* first = nullptr;
+    size_t write_count = 0u;
+    while (batch)
+    {
+        Request* next = batch->next;
+        batch->next = first;
+        first = batch;
+        if (!batch->sql.empty()) ++write_count;
+        batch = next;
+    }
+
+    // One transaction per batch: one commit (one disk sync) however many writes queued up
+    const bool in_transaction = write_count > 1u && db_.execute_query("BEGIN IMMEDIATE;");
+    for (Request* request = first; request; request = request->next)
+    {
+        if (request->sql.empty())
+        {
+            request->succeeded = true;
+            continue;
+        }
+        request->succeeded = db_.execute_prepared(request->sql, request->params);
+        if (!request->succeeded && !request->result)
+        {
+            LOG_ERROR(get_global_logger(), "Queued database write failed: {}", request->sql);
+        }
+    }
+
+    bool committed = true;
+    if (in_transaction && !db_.execute_query("COMMIT;"))
+    {
+        LOG_ERROR(get_global_logger(), "Failed to commit {} queued database writes, rolling back.", write_count);
+        (void)db_.execute_query("ROLLBACK;");
+        committed = false;
+    }
+    if (write_count > 0u) batch_count_.fetch_add(1u, std::memory_order_relaxed);
+    write_count_.fetch_add(write_count, std::memory_order_relaxed);
+
+    // Results are published only after the commit
+    bool stop = false;
+    while (first)
+    {
+        Request* next = first->next;
+        if (first->result) first->result->set_value(first->succeeded && committed);
+        stop |= first->stop;
+        delete first;
+        first = next;
+    }
+    return stop;
+}//!execute_batch
+//---------------------------------------------------------------------------------------
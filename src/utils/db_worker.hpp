@@ -0,0 +1,103 @@
+#pragma once
+#include "defines.hpp"
+#include "database_api.hpp"
+#include <atomic>
+#include <future>
+#include <optional>
+#include <string>
+#include <thread>
+#include <cstdint>
+
+/**
+ * @brief Write-behind worker that runs database writes off the calling thread.
+ *
+ * Producers push requests onto a lock-free stack (one compare-exchange, no
+ * mutex). The worker takes the whole stack at once, restores submission
+ * order and runs every write of that batch inside one transaction, so a
+ * burst of writes costs a single commit. Results are published after the
+ * commit.
+ *
+ * The destructor drains every request submitted before it, so no write is
+ * lost on shutdown. Reads may keep using the Database directly (its calls
+ * are serialized by its own mutex); wait for flush() first to see writes
+ * that are still queued.
+ */
+class Db_worker
+{
+public:
+
+    /**
+     * @brief Starts the worker thread.
+     *
+     * @param db[in] - Open database to write to (must outlive the worker).
+     */
+    explicit Db_worker(Database& db);
+
+    /** @brief Runs all queued writes, then stops and joins the worker. */
+    ~Db_worker() noexcept;
+
+    Db_worker(const Db_worker&) = delete;
+    Db_worker& operator=(const Db_worker&) = delete;
+
+    /**
+     * @brief Queues a write and returns immediately (failures are logged).
+     *
+     * @param sql[in]    - SQL with {} placeholders (see Database::execute_prepared).
+     * @param params[in] - Parameters to bind.
+     */
+    void submit(std::string sql, Database::Param_array params);
+
+    /**
+     * @brief Queues a write and returns its result as a future.
+     *
+     * @returns Future set to true once the write succeeded and its transaction committed.
+     */
+    FLEV_NODISCARD std::future<bool> submit_with_result(std::string sql, Database::Param_array params);
+
+    /** @returns Future set once every write submitted before this call has been committed (false if its commit failed). */
+    FLEV_NODISCARD std::future<bool> flush();
+
+    /** @returns Number of transactions (batches) run so far. */
+    FLEV_NODISCARD uint64_t get_batch_count() const;
+
+    /** @returns Number of writes run so far. */
+    FLEV_NODISCARD uint64_t get_write_count() const;
+
+private/*types*/:
+
+    /** @brief Queued write, flush marker or stop marker (node of the submission stack). */
+    struct Request
+    {
+        std::string sql;                          ///< SQL with {} placeholders (empty for markers).
+        Database::Param_array params;             ///< Parameters to bind.
+        std::optional<std::promise<bool>> result; ///< Set after the batch commits (fire-and-forget if empty).
+        bool stop = false;                        ///< Stop marker (pushed by the destructor).
+        bool succeeded = false;                   ///< Outcome of the write.
+        Request* next = nullptr;                  ///< Next request of the stack or batch.
+    };
+
+private/*methods*/:
+
+    /** @brief Pushes a request onto the submission stack and wakes the worker. */
+    void push(Request* request);
+
+    /** @brief Worker thread body. */
+    void run();
+
+    /**
+     * @brief Runs a batch taken from the stack in one transaction and frees it.
+     *
+     * @param batch[in] - Requests in reverse submission order (as taken from the stack).
+     *
+     * @returns true if the batch contained the stop marker.
+     */
+    bool execute_batch(Request* batch);
+
+private/*vars*/:
+
+    Database& db_;                           ///< Written database.
+    std::atomic<Request*> head_{ nullptr };  ///< Top of the submission stack (latest request).
+    std::atomic<uint64_t> batch_count_{ 0 }; ///< Batches run.
+    std::atomic<uint64_t> write_count_{ 0 }; ///< Writes run.
+    std::thread thread_;                     ///< Worker thread (started last).
+};
@@ -16,6 +16,11 @@
 #  define FLEV_STRINGIFY(x) FLEV_AS_STR(x)
 #endif // !FLEV_AS_STR
 
+#ifndef FLEV_CONCAT
+#  define FLEV_CONCAT_IMPL(a, b) a##b
+#  define FLEV_CONCAT(a, b) FLEV_CONCAT_IMPL(a, b)
+#endif // !FLEV_CONCAT
+
 #ifndef FLEV_FALSE_ASSERT
 #  define FLEV_FALSE_ASSERT(t) (sizeof(t) == 0)
 #endif // !FLEV_FALSE_ASSERT
@@ -61,6 +66,30 @@
 #endif // !FLEV_DEBUG_NAMESPACE_BEGIN
 
 
+/** PROFILING BLOCK */
+
+// Enabled in debug builds, in release only with FLEV_ENABLE_PROFILING (see utils/profiler.hpp)
+#ifndef FLEV_PROFILING_ENABLED
+#  if defined(FLEV_ENABLE_PROFILING) || !defined(NDEBUG)
+#    define FLEV_PROFILING_ENABLED 1
+#  else
+#    define FLEV_PROFILING_ENABLED 0
+#  endif
+#endif // !FLEV_PROFILING_ENABLED
+
+#if FLEV_PROFILING_ENABLED
+#  define FLEV_PROFILE_ZONE(name)                                   \
+     ::flev::profiler::Scoped_zone                                  \
+         FLEV_CONCAT(flev_profile_zone_, FLEV_LINE_NO)(name)
+#  define FLEV_PROFILE_FUNCTION() FLEV_PROFILE_ZONE(__func__)
+#  define FLEV_PROFILE_THREAD(name) ::flev::profiler::set_thread_name(name)
+#else
+#  define FLEV_PROFILE_ZONE(name) FLEV_DO_NOTHING
+#  define FLEV_PROFILE_FUNCTION() FLEV_DO_NOTHING
+#  define FLEV_PROFILE_THREAD(name) FLEV_DO_NOTHING
+#endif // FLEV_PROFILING_ENABLED
+
+
 /** DEBUG ONLY BLOCK */
 #ifndef NDEBUG
 
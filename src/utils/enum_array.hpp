@@ -0,0 +1,46 @@
+#pragma once
+#include "defines.hpp"
+#include <array>
+#include <cstddef>
+
+/** @brief Number of enumerators of an enum class whose last enumerator is Count. */
+template <typename Enum>
+constexpr size_t enum_count = static_cast<size_t>(Enum::Count);
+
+/** @returns All enumerators of Enum in declaration order (Count excluded). */
+template <typename Enum>
+constexpr std::array<Enum, enum_count<Enum>> enum_values()
+{
+    std::array<Enum, enum_count<Enum>> values{};
+    for (size_t i = 0; i < values.size(); ++i) values[i] = static_cast<Enum>(i);
+    return values;
+}//!enum_values
+
+/**
+ * @brief Flat array indexed by an enum class (Count-terminated).
+ *
+ * Replaces string-keyed maps when the key set is fixed at compile time:
+ * a lookup is a single index, with no hashing, compares or allocation.
+ */
+template <typename Enum, typename T>
+class Enum_array
+{
+public:
+
+    /** @returns Value stored for the key. */
+    FLEV_NODISCARD constexpr T& operator[](const Enum key) { return values_[static_cast<size_t>(key)]; }
+    FLEV_NODISCARD constexpr const T& operator[](const Enum key) const { return values_[static_cast<size_t>(key)]; }
+
+    /** @returns Iterators over values in enumerator order. */
+    FLEV_NODISCARD constexpr auto begin() { return values_.begin(); }
+    FLEV_NODISCARD constexpr auto end() { return values_.end(); }
+    FLEV_NODISCARD constexpr auto begin() const { return values_.begin(); }
+    FLEV_NODISCARD constexpr auto end() const { return values_.end(); }
+
+    /** @returns Number of keys. */
+    FLEV_NODISCARD static constexpr size_t size() { return enum_count<Enum>; }
+
+private:
+
+    std::array<T, enum_count<Enum>> values_{}; ///< Value per enumerator.
+};
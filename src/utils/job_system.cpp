@@ -0,0 +1,135 @@
+#include "job_system.hpp"
+#include <algorithm>
+
+Job_system::Job_system(const size_t worker_count)
+{
+    queues_.reserve(worker_count + 1u);
+    for (size_t i = 0; i <= worker_count; ++i) queues_.push_back(std::make_unique<Chunk_queue>());
+
+    workers_.reserve(worker_count);
+    for (size_t i = 0; i < worker_count; ++i)
+    {
+        workers_.emplace_back([this, i] { worker_loop(i + 1u); });
+    }
+}//!Job_system
+//---------------------------------------------------------------------------------------
+
+Job_system::~Job_system() noexcept
+{
+    {
+        std::lock_guard lock(wake_mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    for (auto& worker : workers_) worker.join();
+}//!~Job_system
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD size_t Job_system::get_thread_count() const
+{
+    return queues_.size();
+}//!get_thread_count
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD size_t Job_system::get_chunk_count(const size_t count, const size_t min_chunk) const
+{
+    if (count == 0u) return 0u;
+    const size_t by_size = (count + std::max<size_t>(min_chunk, 1u) - 1u) / std::max<size_t>(min_chunk, 1u);
+    return std::clamp<size_t>(by_size, 1u, max_chunks_);
+}//!get_chunk_count
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD size_t Job_system::get_default_worker_count()
+{
+    const size_t cores = std::thread::hardware_concurrency();
+    return cores > 1u ? cores - 1u : 0u;
+}//!get_default_worker_count
+//---------------------------------------------------------------------------------------
+
+void Job_system::run_batch(const size_t count, const size_t min_chunk, void* context, const Invoke invoke)
+{
+    const size_t chunk_count = get_chunk_count(count, min_chunk);
+    if (chunk_count == 0u) return;
+    if (chunk_count == 1u || workers_.empty())
+    {
+        // Same chunk boundaries as the parallel path, run in order on the caller
+        for (size_t i = 0; i < chunk_count; ++i) invoke(context, count * i / chunk_count, count * (i + 1u) / chunk_count, i);
+        return;
+    }
+
+    context_ = context;
+    invoke_ = invoke;
+    remaining_.store(chunk_count, std::memory_order_relaxed);
+    for (size_t i = 0; i < chunk_count; ++i)
+    {
+        auto& queue = *queues_[i % queues_.size()];
+        std::lock_guard lock(queue.mutex);
+        queue.chunks.push_back({ count * i / chunk_count, count * (i + 1u) / chunk_count, i });
+    }
+    {
+        std::lock_guard lock(wake_mutex_);
+        ++batch_id_;
+    }
+    wake_.notify_all();
+
+    drain(0u);
+    while (remaining_.load(std::memory_order_acquire) != 0u)
+    {
+        std::this_thread::yield(); // Last chunks are finishing on workers
+    }
+}//!run_batch
+//---------------------------------------------------------------------------------------
+
+void Job_system::worker_loop(const size_t queue_id)
+{
+    uint64_t seen_batch = 0u;
+    while (true)
+    {
+        {
+            std::unique_lock lock(wake_mutex_);
+            wake_.wait(lock, [&] { return stopping_ || batch_id_ != seen_batch; });
+            if (stopping_) return;
+            seen_batch = batch_id_;
+        }
+        drain(queue_id);
+    }
+}//!worker_loop
+//---------------------------------------------------------------------------------------
+
+void Job_system::drain(const size_t queue_id)
+{
+    Chunk chunk;
+    while (true)
+    {
+        bool found = pop_chunk(queue_id, false, chunk);
+        for (size_t offset = 1; !found && offset < queues_.size(); ++offset)
+        {
+            found = pop_chunk((queue_id + offset) % queues_.size(), true, chunk);
+        }
+        if (!found) return;
+
+        invoke_(context_, chunk.begin, chunk.end, chunk.index);
+        remaining_.fetch_sub(1u, std::memory_order_release);
+    }
+}//!drain
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD bool Job_system::pop_chunk(const size_t queue_id, const bool steal, Chunk& out_chunk)
+{
+    auto& queue = *queues_[queue_id];
+    std::lock_guard lock(queue.mutex);
+    if (queue.chunks.empty()) return false;
+
+    if (steal)
+    {
+        out_chunk = queue.chunks.front();
+        queue.chunks.pop_front();
+    }
+    else
+    {
+        out_chunk = queue.chunks.back();
+        queue.chunks.pop_back();
+    }
+    return true;
+}//!pop_chunk
+//---------------------------------------------------------------------------------------
@@ -0,0 +1,126 @@
+#pragma once
+#include "defines.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include <cstdint>
+
+/**
+ * @brief Small work-stealing thread pool for data-parallel loops.
+ *
+ * parallel_for() splits a row range into chunks and deals them round-robin
+ * into one queue per thread. Every thread (the caller included) drains its
+ * own queue from the back and steals from the front of the others when it
+ * runs dry, so uneven chunks balance out. The call returns once every chunk
+ * has run.
+ *
+ * Chunk boundaries depend only on the row count and the chunk size, never
+ * on which thread runs a chunk, so results merged in chunk order are the
+ * same on any core count. One loop runs at a time; parallel_for() must not
+ * be called from inside a chunk.
+ */
+class Job_system
+{
+public:
+
+    /**
+     * @brief Starts worker threads.
+     *
+     * @param worker_count[in][opt] - Threads besides the caller (0 runs everything on the caller). [Default: cores - 1]
+     */
+    explicit Job_system(const size_t worker_count = get_default_worker_count());
+
+    /** @brief Stops and joins all workers. */
+    ~Job_system() noexcept;
+
+    Job_system(const Job_system&) = delete;
+    Job_system& operator=(const Job_system&) = delete;
+
+    /** @returns Threads running chunks (workers plus the calling thread). */
+    FLEV_NODISCARD size_t get_thread_count() const;
+
+    /**
+     * @brief Number of chunks parallel_for() splits count rows into.
+     *
+     * Use it to size per-chunk output buffers before the loop. Does not
+     * depend on the number of threads.
+     *
+     * @param count[in]     - Rows to process.
+     * @param min_chunk[in] - Smallest chunk worth handing to another thread.
+     */
+    FLEV_NODISCARD size_t get_chunk_count(const size_t count, const size_t min_chunk) const;
+
+    /**
+     * @brief Runs fn(begin, end, chunk_index) over [0, count) in parallel and waits.
+     *
+     * @param count[in]     - Rows to process.
+     * @param min_chunk[in] - Smallest chunk worth handing to another thread.
+     * @param fn[in]        - Chunk callback; chunks write disjoint rows or per-chunk buffers.
+     */
+    template <typename F>
+    void parallel_for(const size_t count, const size_t min_chunk, F&& fn)
+    {
+        using Fn = std::remove_reference_t<F>;
+        void* context = const_cast<void*>(static_cast<const void*>(std::addressof(fn)));
+        run_batch(count, min_chunk, context, [](void* context, const size_t begin, const size_t end, const size_t chunk) {
+            (*static_cast<Fn*>(context))(begin, end, chunk);
+        });
+    }//!parallel_for
+
+    /** @returns hardware_concurrency() - 1, at least 0. */
+    FLEV_NODISCARD static size_t get_default_worker_count();
+
+private/*types*/:
+
+    using Invoke = void(*)(void* context, const size_t begin, const size_t end, const size_t chunk);
+
+    /** @brief Row range of one chunk. */
+    struct Chunk
+    {
+        size_t begin = 0; ///< First row.
+        size_t end = 0;   ///< One past the last row.
+        size_t index = 0; ///< Position of the chunk in the loop.
+    };
+
+    /** @brief Chunk deque of one thread (owner pops the back, thieves take the front). */
+    struct Chunk_queue
+    {
+        std::mutex mutex;          ///< Guards chunks.
+        std::deque<Chunk> chunks;  ///< Pending chunks.
+    };
+
+private/*methods*/:
+
+    /** @brief Splits the loop into chunks, wakes workers and helps until every chunk is done. */
+    void run_batch(const size_t count, const size_t min_chunk, void* context, const Invoke invoke);
+
+    /** @brief Worker thread body. */
+    void worker_loop(const size_t queue_id);
+
+    /** @brief Runs chunks from own queue, then stolen ones, until all queues are empty. */
+    void drain(const size_t queue_id);
+
+    /** @returns true and the next chunk of the queue (back for the owner, front for thieves). */
+    FLEV_NODISCARD bool pop_chunk(const size_t queue_id, const bool steal, Chunk& out_chunk);
+
+private/*vars*/:
+
+    static constexpr size_t max_chunks_ = 64u;         ///< Upper bound on chunks per loop (about 4 per thread on 16 cores).
+
+    std::vector<std::unique_ptr<Chunk_queue>> queues_; ///< Queue per thread; 0 belongs to the caller.
+    std::vector<std::thread> workers_;                 ///< Worker threads (queue i + 1).
+
+    void* context_ = nullptr;                          ///< Callback state of the running loop.
+    Invoke invoke_ = nullptr;                          ///< Callback of the running loop.
+    std::atomic<size_t> remaining_{ 0 };               ///< Chunks of the running loop not finished yet.
+
+    std::mutex wake_mutex_;                            ///< Guards batch_id_ and stopping_.
+    std::condition_variable wake_;                     ///< Signals a new loop or shutdown.
+    uint64_t batch_id_ = 0u;                           ///< Incremented per loop.
+    bool stopping_ = false;                            ///< Set on destruction.
+};
@@ -0,0 +1,203 @@
+#include "profiler.hpp"
+#include "logger.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+FLEV_NAMESPACE_BEGIN
+namespace profiler {
+
+namespace
+{
+    using Profiler_clock = std::chrono::steady_clock;
+
+    constexpr size_t ring_capacity = 1u << 16; ///< Zones kept per thread (~2 MB).
+
+    /** @brief Finished zone (as read from a slot). */
+    struct Zone_event
+    {
+        const char* name = nullptr; ///< Zone name.
+        uint64_t start_ns = 0u;     ///< Start since profiler epoch.
+        uint64_t duration_ns = 0u;  ///< Zone duration.
+    };
+
+    /**
+     * @brief Ring slot holding one finished zone.
+     *
+     * Slots are published like a seqlock: sequence is 0 while the owner thread
+     * rewrites the slot and zone index + 1 once the zone is complete, so the dump
+     * can tell a slot overwritten under it from a consistent one.
+     */
+    struct Zone_slot
+    {
+        std::atomic<uint64_t> sequence = 0u;       ///< Index + 1 of the zone held (0 while being written).
+        std::atomic<const char*> name = nullptr;   ///< Zone name.
+        std::atomic<uint64_t> start_ns = 0u;       ///< Start since profiler epoch.
+        std::atomic<uint64_t> duration_ns = 0u;    ///< Zone duration.
+    };
+
+    /** @brief Zones recorded by one thread. */
+    struct Thread_buffer
+    {
+        std::vector<Zone_slot> slots = std::vector<Zone_slot>(ring_capacity); ///< Ring storage (written by the owner thread only).
+        std::atomic<uint64_t> head = 0u;                                     ///< Zones written so far.
+        uint32_t thread_id = 0u;                                             ///< Trace thread id.
+        std::atomic<const char*> name = nullptr;                             ///< Thread name (if set).
+    };
+
+    /** @brief All thread buffers (kept after thread exit so their zones can still be dumped). */
+    struct Registry
+    {
+        std::mutex mutex;                                    ///< Guards buffers.
+        std::vector<std::shared_ptr<Thread_buffer>> buffers; ///< Buffer per thread that recorded zones.
+        const Profiler_clock::time_point epoch = Profiler_clock::now(); ///< Trace time zero.
+    };
+
+    Registry& get_registry()
+    {
+        static Registry registry;
+        return registry;
+    }//!get_registry
+
+    /** @returns Buffer of the calling thread (registered on first use). */
+    Thread_buffer& get_thread_buffer()
+    {
+        thread_local const std::shared_ptr<Thread_buffer> buffer = [] {
+            auto& registry = get_registry();
+            auto result = std::make_shared<Thread_buffer>();
+            std::lock_guard lock(registry.mutex);
+            result->thread_id = static_cast<uint32_t>(registry.buffers.size() + 1u);
+            registry.buffers.push_back(result);
+            return result;
+        }();
+        return *buffer;
+    }//!get_thread_buffer
+
+    /** @returns Nanoseconds since profiler epoch. */
+    uint64_t now_ns()
+    {
+        const auto elapsed = Profiler_clock::now() - get_registry().epoch;
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    }//!now_ns
+
+    /** @brief Writes a string as JSON string literal. */
+    void write_json_string(std::ostream& out, const char* text)
+    {
+        out << '"';
+        for (; *text; ++text)
+        {
+            if (*text == '"' || *text == '\\') out << '\\';
+            out << *text;
+        }
+        out << '"';
+    }//!write_json_string
+}
+
+Scoped_zone::Scoped_zone(const char* name) noexcept
+    : name_(name)
+    , start_ns_(now_ns())
+{
+}//!Scoped_zone
+//---------------------------------------------------------------------------------------
+
+Scoped_zone::~Scoped_zone()
+{
+    const auto end_ns = now_ns();
+    auto& buffer = get_thread_buffer();
+    const auto head = buffer.head.load(std::memory_order_relaxed);
+    auto& slot = buffer.slots[head % ring_capacity];
+
+    // Mark the slot as being written before any field changes (pairs with the acquire fence of the dump)
+    slot.sequence.store(0u, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.name.store(name_, std::memory_order_relaxed);
+    slot.start_ns.store(start_ns_, std::memory_order_relaxed);
+    slot.duration_ns.store(end_ns - start_ns_, std::memory_order_relaxed);
+    slot.sequence.store(head + 1u, std::memory_order_release);
+    buffer.head.store(head + 1u, std::memory_order_release);
+}//!~Scoped_zone
+//---------------------------------------------------------------------------------------
+
+void set_thread_name(const char* name)
+{
+    get_thread_buffer().name.store(name, std::memory_order_relaxed);
+}//!set_thread_name
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD bool dump_chrome_trace(const std::string& path)
+{
+    std::ofstream file(path);
+    if (!file.is_open())
+    {
+        LOG_ERROR(get_global_logger(), "Failed to open trace file: {}", path);
+        return false;
+    }
+
+    auto& registry = get_registry();
+    std::vector<std::shared_ptr<Thread_buffer>> buffers;
+    {
+        std::lock_guard lock(registry.mutex);
+        buffers = registry.buffers;
+    }
+
+    size_t zone_count = 0u;
+    bool first = true;
+    const auto separator = [&file, &first]() -> std::ostream& {
+        if (!first) file << ",\n";
+        first = false;
+        return file;
+    };
+
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    for (const auto& buffer : buffers)
+    {
+        if (const auto* name = buffer->name.load(std::memory_order_relaxed))
+        {
+            separator() << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":" << buffer->thread_id << ",\"args\":{\"name\":";
+            write_json_string(file, name);
+            file << "}}";
+        }
+
+        // Oldest surviving zone first; slots the owner overwrites meanwhile fail the sequence check
+        const auto head = buffer->head.load(std::memory_order_acquire);
+        const auto count = std::min<uint64_t>(head, ring_capacity);
+        for (auto i = head - count; i < head; ++i)
+        {
+            const auto& slot = buffer->slots[i % ring_capacity];
+            const auto sequence = slot.sequence.load(std::memory_order_acquire);
+            if (sequence != i + 1u) continue;
+            const Zone_event event = {
+                slot.name.load(std::memory_order_relaxed),
+                slot.start_ns.load(std::memory_order_relaxed),
+                slot.duration_ns.load(std::memory_order_relaxed)
+            };
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.sequence.load(std::memory_order_relaxed) != sequence || !event.name) continue;
+
+            separator() << "{\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->thread_id
+                << ",\"ts\":" << event.start_ns / 1000u << '.' << (event.start_ns % 1000u) / 100u
+                << ",\"dur\":" << event.duration_ns / 1000u << '.' << (event.duration_ns % 1000u) / 100u
+                << ",\"name\":";
+            write_json_string(file, event.name);
+            file << '}';
+            ++zone_count;
+        }
+    }
+    file << "\n]}\n";
+
+    if (!file)
+    {
+        LOG_ERROR(get_global_logger(), "Failed to write trace file: {}", path);
+        return false;
+    }
+    LOG_INFO(get_global_logger(), "Profiler trace with {} zones from {} threads written to {}.", zone_count, buffers.size(), path);
+    return true;
+}//!dump_chrome_trace
+//---------------------------------------------------------------------------------------
+
+} // namespace profiler
+FLEV_NAMESPACE_END
@@ -0,0 +1,52 @@
+#pragma once
+#include "defines.hpp"
+#include <cstdint>
+#include <string>
+
+FLEV_NAMESPACE_BEGIN
+namespace profiler {
+
+/**
+ * @brief Records the lifetime of a scope as a trace zone.
+ *
+ * Zones go to a ring buffer owned by the current thread (oldest zones are
+ * overwritten), so recording takes no lock. Use FLEV_PROFILE_ZONE instead of
+ * constructing it directly, so the zone compiles out with profiling disabled.
+ *
+ * @note The name must outlive the trace dump (string literals, __func__).
+ */
+class Scoped_zone
+{
+public:
+    /** @brief Starts the zone. */
+    explicit Scoped_zone(const char* name) noexcept;
+
+    /** @brief Ends the zone and records it. */
+    ~Scoped_zone();
+
+    Scoped_zone(const Scoped_zone&) = delete;
+    Scoped_zone& operator=(const Scoped_zone&) = delete;
+
+private:
+    const char* name_;  ///< Zone name.
+    uint64_t start_ns_; ///< Start time since profiler epoch.
+};
+
+/** @brief Names the current thread in the trace (the name must be a literal). */
+void set_thread_name(const char* name);
+
+/**
+ * @brief Writes recorded zones of all threads as Chrome trace JSON.
+ *
+ * The file opens in Perfetto or chrome://tracing. Other threads may keep
+ * recording during the dump: zones whose slot is overwritten while it is
+ * read are skipped, never written torn.
+ *
+ * @param path[in] - Output file path.
+ *
+ * @returns false if the file could not be written.
+ */
+FLEV_NODISCARD bool dump_chrome_trace(const std::string& path);
+
+} // namespace profiler
+FLEV_NAMESPACE_END
@@ -0,0 +1,50 @@
+#pragma once
+#include "defines.hpp"
+#include <cstdint>
+
+/**
+ * @brief Small deterministic random generator (PCG32).
+ *
+ * The sequence depends only on the seed, unlike rand() which is shared
+ * process-wide state, so a run can be reproduced from its seed.
+ */
+class Rng
+{
+public:
+
+    /** @brief Seeds the generator. */
+    explicit Rng(const uint64_t seed = 0u) { reseed(seed); }
+
+    /** @brief Restarts the sequence from the given seed. */
+    void reseed(const uint64_t seed)
+    {
+        state_ = 0u;
+        (void)next();
+        state_ += seed;
+        (void)next();
+    }//!reseed
+
+    /** @returns Next 32 random bits. */
+    uint32_t next()
+    {
+        const auto old_state = state_;
+        state_ = old_state * 6364136223846793005ull + increment_;
+        const auto xorshifted = static_cast<uint32_t>(((old_state >> 18u) ^ old_state) >> 27u);
+        const auto rot = static_cast<uint32_t>(old_state >> 59u);
+        return (xorshifted >> rot) | (xorshifted << ((0u - rot) & 31u));
+    }//!next
+
+    /** @returns Random integer in [0, bound) (0 if bound is 0). */
+    uint32_t next_below(const uint32_t bound)
+    {
+        if (bound == 0u) return 0u;
+        return static_cast<uint32_t>((static_cast<uint64_t>(next()) * bound) >> 32u);
+    }//!next_below
+
+    /** @returns Internal state (part of the world state hash). */
+    FLEV_NODISCARD uint64_t get_state() const { return state_; }
+
+private:
+    static constexpr uint64_t increment_ = 1442695040888963407ull; ///< Stream selector (must be odd).
+    uint64_t state_ = 0u;                                          ///< Generator state.
+};
@@ -0,0 +1,87 @@
+#pragma once
+#include "defines.hpp"
+#include <algorithm>
+#include <cstdint>
+
+/**
+ * @brief Simulation time source owned by a scene.
+ *
+ * Time only moves when the owner calls advance() with the fixed tick dt, so
+ * it stops while paused and runs exactly as fast as ticks are executed.
+ * Time scale is a request to the driver (Main_window) to execute more or
+ * fewer ticks per real second; dt itself stays fixed so runs stay reproducible.
+ */
+class Sim_clock
+{
+public:
+
+    /**
+     * @brief Advances simulation time by one tick.
+     *
+     * @param dt[in] - Tick duration in seconds.
+     *
+     * @returns Simulated time step (0 while paused).
+     */
+    float advance(const float dt)
+    {
+        if (paused_) return 0.f;
+        now_ += dt;
+        ++tick_;
+        return dt;
+    }//!advance
+
+    /** @brief Stops simulation time. */
+    void pause() { paused_ = true; }
+
+    /** @brief Resumes simulation time. */
+    void resume() { paused_ = false; }
+
+    /** @returns true if simulation time is stopped. */
+    FLEV_NODISCARD bool is_paused() const { return paused_; }
+
+    /**
+     * @brief Sets simulation speed relative to real time.
+     *
+     * @param scale[in] - 1 is real time, 4 is fast-forward x4. Clamped to [0.1, 64].
+     */
+    void set_time_scale(const float scale) { time_scale_ = std::clamp(scale, 0.1f, 64.f); }
+
+    /** @returns Simulation speed relative to real time. */
+    FLEV_NODISCARD float get_time_scale() const { return time_scale_; }
+
+    /** @returns Simulation time since creation (seconds). */
+    FLEV_NODISCARD double now() const { return now_; }
+
+    /** @returns Number of executed (not paused) ticks. */
+    FLEV_NODISCARD uint64_t get_tick() const { return tick_; }
+
+private:
+    double now_ = 0.0;        ///< Simulated seconds.
+    uint64_t tick_ = 0u;      ///< Executed ticks.
+    float time_scale_ = 1.f;  ///< Requested speed relative to real time.
+    bool paused_ = false;     ///< Pause flag.
+};
+
+/** @brief Stopwatch reading a Sim_clock (drop-in for gameplay sf::Clock usages). */
+class Sim_timer
+{
+public:
+
+    /** @brief Starts the timer at the current simulation time. */
+    explicit Sim_timer(const Sim_clock& clock) : clock_(&clock), start_(clock.now()) {}
+
+    /** @returns Simulation seconds since start or last restart. */
+    FLEV_NODISCARD float get_elapsed() const { return static_cast<float>(clock_->now() - start_); }
+
+    /** @brief Restarts the timer and returns elapsed seconds before restart. */
+    float restart()
+    {
+        const auto elapsed = get_elapsed();
+        start_ = clock_->now();
+        return elapsed;
+    }//!restart
+
+private:
+    const Sim_clock* clock_; ///< Time source.
+    double start_;           ///< Start time (simulation seconds).
+};
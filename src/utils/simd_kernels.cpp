@@ -0,0 +1,148 @@
+#include "simd_kernels.hpp"
+#include <algorithm>
+#include <cassert>
+#include <bit>
+
+#if defined(__AVX2__)
+#  include <immintrin.h>
+#  define FLEV_SIMD_AVX2 1
+#endif // __AVX2__
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  include <emmintrin.h>
+#  define FLEV_SIMD_SSE2 1
+#endif // SSE2
+
+FLEV_NAMESPACE_BEGIN
+namespace simd {
+
+// Kernels treat the arrays as flat floats
+static_assert(sizeof(sf::Vector2f) == 2 * sizeof(float), "sf::Vector2f must be two packed floats");
+static_assert(sizeof(sf::FloatRect) == 4 * sizeof(float), "sf::FloatRect must be four packed floats");
+
+namespace
+{
+    /** @brief Box normalized to min/max corners. */
+    struct Min_max
+    {
+        float min_x, min_y, max_x, max_y;
+    };
+
+    Min_max to_min_max(const sf::FloatRect& box)
+    {
+        const float x1 = box.position.x + box.size.x;
+        const float y1 = box.position.y + box.size.y;
+        return {
+            std::min(box.position.x, x1), std::min(box.position.y, y1),
+            std::max(box.position.x, x1), std::max(box.position.y, y1)
+        };
+    }//!to_min_max
+
+    /** @returns true if the boxes overlap (same comparisons as findIntersection). */
+    bool overlaps(const Min_max& a, const Min_max& b)
+    {
+        return std::max(a.min_x, b.min_x) < std::min(a.max_x, b.max_x)
+            && std::max(a.min_y, b.min_y) < std::min(a.max_y, b.max_y);
+    }//!overlaps
+}
+
+void integrate(std::span<sf::Vector2f> positions, std::span<const sf::Vector2f> velocities, const float dt)
+{
+    assert(velocities.size() >= positions.size() && "Missing velocities");
+
+    float* pos = reinterpret_cast<float*>(positions.data());
+    const float* vel = reinterpret_cast<const float*>(velocities.data());
+    const size_t count = positions.size() * 2u;
+    size_t i = 0;
+
+#if defined(FLEV_SIMD_AVX2)
+    const __m256 dt8 = _mm256_set1_ps(dt);
+    for (; i + 8u <= count; i += 8u)
+    {
+        const __m256 p = _mm256_loadu_ps(pos + i);
+        const __m256 v = _mm256_loadu_ps(vel + i);
+        _mm256_storeu_ps(pos + i, _mm256_add_ps(p, _mm256_mul_ps(v, dt8)));
+    }
+#endif // FLEV_SIMD_AVX2
+
+#if defined(FLEV_SIMD_SSE2)
+    const __m128 dt4 = _mm_set1_ps(dt);
+    for (; i + 4u <= count; i += 4u)
+    {
+        const __m128 p = _mm_loadu_ps(pos + i);
+        const __m128 v = _mm_loadu_ps(vel + i);
+        _mm_storeu_ps(pos + i, _mm_add_ps(p, _mm_mul_ps(v, dt4)));
+    }
+#endif // FLEV_SIMD_SSE2
+
+    for (; i < count; ++i)
+    {
+        pos[i] += vel[i] * dt;
+    }
+}//!integrate
+//---------------------------------------------------------------------------------------
+
+size_t overlap_mask(const sf::FloatRect& query, std::span<const sf::FloatRect> boxes, std::span<uint8_t> out_hits)
+{
+    assert(out_hits.size() >= boxes.size() && "Hit mask is too small");
+
+    const auto q = to_min_max(query);
+    size_t hit_count = 0u;
+    size_t i = 0;
+
+#if defined(FLEV_SIMD_SSE2)
+    const __m128 q_min_x = _mm_set1_ps(q.min_x);
+    const __m128 q_min_y = _mm_set1_ps(q.min_y);
+    const __m128 q_max_x = _mm_set1_ps(q.max_x);
+    const __m128 q_max_y = _mm_set1_ps(q.max_y);
+    const float* data = reinterpret_cast<const float*>(boxes.data());
+    for (; i + 4u <= boxes.size(); i += 4u)
+    {
+        // Four boxes (x, y, w, h) -> columns of x, y, w and h
+        __m128 x = _mm_loadu_ps(data + i * 4u);
+        __m128 y = _mm_loadu_ps(data + i * 4u + 4u);
+        __m128 w = _mm_loadu_ps(data + i * 4u + 8u);
+        __m128 h = _mm_loadu_ps(data + i * 4u + 12u);
+        _MM_TRANSPOSE4_PS(x, y, w, h);
+
+        const __m128 x1 = _mm_add_ps(x, w);
+        const __m128 y1 = _mm_add_ps(y, h);
+        const __m128 left = _mm_max_ps(q_min_x, _mm_min_ps(x, x1));
+        const __m128 right = _mm_min_ps(q_max_x, _mm_max_ps(x, x1));
+        const __m128 top = _mm_max_ps(q_min_y, _mm_min_ps(y, y1));
+        const __m128 bottom = _mm_min_ps(q_max_y, _mm_max_ps(y, y1));
+        const __m128 hit = _mm_and_ps(_mm_cmplt_ps(left, right), _mm_cmplt_ps(top, bottom));
+
+        const int mask = _mm_movemask_ps(hit);
+        for (size_t k = 0; k < 4u; ++k)
+        {
+            out_hits[i + k] = static_cast<uint8_t>((mask >> k) & 1);
+        }
+        hit_count += static_cast<size_t>(std::popcount(static_cast<unsigned>(mask)));
+    }
+#endif // FLEV_SIMD_SSE2
+
+    for (; i < boxes.size(); ++i)
+    {
+        const bool hit = overlaps(q, to_min_max(boxes[i]));
+        out_hits[i] = hit ? 1u : 0u;
+        hit_count += hit ? 1u : 0u;
+    }
+    return hit_count;
+}//!overlap_mask
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD const char* get_instruction_set()
+{
+#if defined(FLEV_SIMD_AVX2)
+    return "avx2";
+#elif defined(FLEV_SIMD_SSE2)
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}//!get_instruction_set
+//---------------------------------------------------------------------------------------
+
+} // namespace simd
+FLEV_NAMESPACE_END
@@ -0,0 +1,42 @@
+#pragma once
+#include "defines.hpp"
+#include <SFML/Graphics.hpp>
+#include <span>
+#include <cstdint>
+
+FLEV_NAMESPACE_BEGIN
+namespace simd {
+
+/**
+ * @brief Moves every point along its velocity: positions[i] += velocities[i] * dt.
+ *
+ * Works on the interleaved x/y floats of the whole array at once (AVX2 when
+ * the library is built with FLEV_ENABLE_AVX2, SSE2 on x86-64, scalar
+ * otherwise). Results are bit-identical to the scalar loop, so replays stay
+ * valid across builds.
+ *
+ * @param positions[in][out] - Points to move.
+ * @param velocities[in]     - Velocity per point (at least positions.size() entries).
+ * @param dt[in]             - Time step in seconds.
+ */
+void integrate(std::span<sf::Vector2f> positions, std::span<const sf::Vector2f> velocities, const float dt);
+
+/**
+ * @brief Tests one box against many boxes.
+ *
+ * Uses the same rule as sf::FloatRect::findIntersection (negative sizes are
+ * normalized, touching edges do not overlap), four boxes per SSE2 step.
+ *
+ * @param query[in]     - Box to test.
+ * @param boxes[in]     - Boxes to test against.
+ * @param out_hits[out] - Receives 1 for every overlapping box, 0 otherwise (at least boxes.size() entries).
+ *
+ * @returns Number of overlapping boxes.
+ */
+size_t overlap_mask(const sf::FloatRect& query, std::span<const sf::FloatRect> boxes, std::span<uint8_t> out_hits);
+
+/** @returns Instruction set used by the kernels ("avx2", "sse2" or "scalar"). */
+FLEV_NODISCARD const char* get_instruction_set();
+
+} // namespace simd
+FLEV_NAMESPACE_END
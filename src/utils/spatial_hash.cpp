@@ -0,0 +1,181 @@
+#include "spatial_hash.hpp"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace
+{
+    /** @brief Runs fn(begin, end, chunk) over count items on the job system (in one chunk without it). */
+    template <typename F>
+    void for_each_chunk(Job_system* job_system, const size_t count, const size_t min_chunk_items, F&& fn)
+    {
+        if (job_system) job_system->parallel_for(count, min_chunk_items, fn);
+        else if (count > 0u) fn(size_t{ 0 }, count, size_t{ 0 });
+    }//!for_each_chunk
+}
+
+Spatial_hash::Spatial_hash(const float min_cell_size, std::pmr::memory_resource* resource)
+    : min_cell_size_(min_cell_size)
+    , cell_size_(min_cell_size)
+    , inv_cell_size_(1.f / min_cell_size)
+    , pool_(resource)
+    , cells_(&pool_)
+{
+}//!Spatial_hash
+//---------------------------------------------------------------------------------------
+
+void Spatial_hash::rebuild(std::span<const sf::FloatRect> bounds, Job_system* job_system, const size_t min_chunk_items)
+{
+    item_count_ = bounds.size();
+
+    // Chunk boundaries only depend on the item count, so sums and pairs merged in chunk order
+    // are the same on any number of threads. Buffers are sized here, chunks only fill their slot
+    size_t chunk_count = bounds.empty() ? 0u : 1u;
+    if (job_system && !bounds.empty()) chunk_count = job_system->get_chunk_count(bounds.size(), min_chunk_items);
+    chunk_extents_.assign(chunk_count, 0.f);
+    if (chunk_entries_.size() < chunk_count) chunk_entries_.resize(chunk_count);
+
+    // Cells are sized to the typical item extent, rounded up to a power of two so that
+    // spawns and kills only re-key the grid when the mean extent crosses a power of two
+    float cell_size = cell_size_;
+    if (!bounds.empty())
+    {
+        for_each_chunk(job_system, bounds.size(), min_chunk_items, [&](const size_t begin, const size_t end, const size_t chunk) {
+            float extent_sum = 0.f;
+            for (size_t i = begin; i < end; ++i)
+            {
+                extent_sum += std::max(std::abs(bounds[i].size.x), std::abs(bounds[i].size.y));
+            }
+            chunk_extents_[chunk] = extent_sum;
+        });
+
+        float extent_sum = 0.f;
+        for (const auto chunk_sum : chunk_extents_) extent_sum += chunk_sum;
+        const float mean_extent = std::max(min_cell_size_, extent_sum / static_cast<float>(bounds.size()));
+        cell_size = static_cast<float>(std::bit_ceil(static_cast<uint32_t>(std::ceil(mean_extent))));
+    }
+
+    if (cell_size != cell_size_)
+    {
+        cells_.clear();
+        cell_size_ = cell_size;
+        inv_cell_size_ = 1.f / cell_size_;
+    }
+    else
+    {
+        // Cells left empty by the previous build are dropped (their nodes go back to the pool),
+        // the others are only cleared and keep their capacity
+        std::erase_if(cells_, [](const auto& cell) { return cell.second.empty(); });
+        for (auto& [_, ids] : cells_) ids.clear();
+    }
+
+    // Cell ranges of all items, in parallel (reads only the cell size)
+    for_each_chunk(job_system, bounds.size(), min_chunk_items, [&](const size_t begin, const size_t end, const size_t chunk) {
+        auto& entries = chunk_entries_[chunk];
+        entries.clear();
+        for (size_t i = begin; i < end; ++i)
+        {
+            int32_t min_x, min_y, max_x, max_y;
+            to_cell_range(bounds[i], min_x, min_y, max_x, max_y);
+
+            for (int32_t y = min_y; y <= max_y; ++y)
+            {
+                for (int32_t x = min_x; x <= max_x; ++x)
+                {
+                    entries.push_back({ make_key(x, y), static_cast<Id>(i) });
+                }
+            }
+        }
+    });
+
+    // The table and its pool are not thread-safe: insert on this thread. Chunks cover ascending
+    // id ranges, so every cell receives its ids in ascending order
+    for (size_t chunk = 0; chunk < chunk_count; ++chunk)
+    {
+        for (const auto& entry : chunk_entries_[chunk])
+        {
+            cells_[entry.key].push_back(entry.id);
+        }
+    }
+}//!rebuild
+//---------------------------------------------------------------------------------------
+
+void Spatial_hash::query(const sf::FloatRect& area, std::pmr::vector<Id>& out_ids) const
+{
+    out_ids.clear();
+    if (item_count_ == 0) return;
+
+    int32_t min_x, min_y, max_x, max_y;
+    to_cell_range(area, min_x, min_y, max_x, max_y);
+
+    for (int32_t y = min_y; y <= max_y; ++y)
+    {
+        for (int32_t x = min_x; x <= max_x; ++x)
+        {
+            const auto it = cells_.find(make_key(x, y));
+            if (it == cells_.end()) continue;
+            out_ids.insert(out_ids.end(), it->second.begin(), it->second.end());
+        }
+    }
+
+    // Items spanning several cells are reported once, in insertion order
+    std::sort(out_ids.begin(), out_ids.end());
+    out_ids.erase(std::unique(out_ids.begin(), out_ids.end()), out_ids.end());
+}//!query
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD float Spatial_hash::get_cell_size() const
+{
+    return cell_size_;
+}//!get_cell_size
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD size_t Spatial_hash::get_item_count() const
+{
+    return item_count_;
+}//!get_item_count
+//---------------------------------------------------------------------------------------
+
+void Spatial_hash::get_occupied_cells(std::pmr::vector<sf::FloatRect>& out_cells) const
+{
+    out_cells.clear();
+    for (const auto& [key, ids] : cells_)
+    {
+        if (ids.empty()) continue; // Occupied by the previous build only
+        const auto x = static_cast<int32_t>(static_cast<uint32_t>(key >> 32));
+        const auto y = static_cast<int32_t>(static_cast<uint32_t>(key));
+        out_cells.push_back({
+            { static_cast<float>(x) * cell_size_, static_cast<float>(y) * cell_size_ },
+            { cell_size_, cell_size_ }
+        });
+    }
+}//!get_occupied_cells
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD int32_t Spatial_hash::to_cell(const float value) const
+{
+    return static_cast<int32_t>(std::floor(value * inv_cell_size_));
+}//!to_cell
+//---------------------------------------------------------------------------------------
+
+void Spatial_hash::to_cell_range(
+    const sf::FloatRect& box,
+    int32_t& min_x, int32_t& min_y,
+    int32_t& max_x, int32_t& max_y
+) const
+{
+    // Rects with negative size are valid for findIntersection, normalize them here too
+    const auto x0 = box.position.x, x1 = box.position.x + box.size.x;
+    const auto y0 = box.position.y, y1 = box.position.y + box.size.y;
+    min_x = to_cell(std::min(x0, x1));
+    max_x = to_cell(std::max(x0, x1));
+    min_y = to_cell(std::min(y0, y1));
+    max_y = to_cell(std::max(y0, y1));
+}//!to_cell_range
+//---------------------------------------------------------------------------------------
+
+FLEV_NODISCARD uint64_t Spatial_hash::make_key(const int32_t x, const int32_t y)
+{
+    return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+}//!make_key
+//---------------------------------------------------------------------------------------
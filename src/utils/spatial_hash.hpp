@@ -0,0 +1,114 @@
+#pragma once
+#include "defines.hpp"
+#include "job_system.hpp"
+#include <SFML/Graphics.hpp>
+#include <memory_resource>
+#include <unordered_map>
+#include <vector>
+#include <span>
+#include <cstdint>
+
+/**
+ * @brief Uniform-grid spatial hash used as collision broadphase.
+ *
+ * The hash is rebuilt from scratch once per tick from a flat array of bounds.
+ * Item ids are indices into that array, so the caller keeps its own mapping
+ * from id to entity. Only cells occupied by the current or previous build are
+ * kept, so the table stays as small as the area the items cover; kept cells
+ * reuse their capacity and erased ones return their memory to an internal pool.
+ *
+ * The per-item part of a rebuild can run on a Job_system: chunks of items
+ * collect their (cell, id) pairs in parallel, then the pairs are inserted
+ * in ascending chunk order, so every cell lists its ids in ascending order
+ * exactly as a serial build does.
+ */
+class Spatial_hash
+{
+public:
+    using Id = uint32_t;
+
+    /**
+     * @brief Constructs an empty hash.
+     *
+     * @param min_cell_size[in][opt] - Lower clamp for the auto-sized cell. [Default: 16]
+     * @param resource[in][opt]      - Upstream of the cell pool (e.g. the level arena). [Default: heap]
+     */
+    explicit Spatial_hash(const float min_cell_size = 16.f, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+    Spatial_hash(const Spatial_hash&) = delete;
+    Spatial_hash& operator=(const Spatial_hash&) = delete;
+
+    /**
+     * @brief Rebuilds the hash from the given bounds.
+     *
+     * Cell size is set to the mean of the largest side of all boxes rounded up
+     * to a power of two, so that a typical item overlaps at most four cells and
+     * cell keys stay stable while the item mix changes.
+     *
+     * @param bounds[in]               - Item bounds; item id equals its index in this array.
+     * @param job_system[in][opt]      - Runs the per-chunk passes (nullptr builds on the calling thread). [Default: nullptr]
+     * @param min_chunk_items[in][opt] - Smallest item range worth running on another thread. [Default: 64]
+     */
+    void rebuild(std::span<const sf::FloatRect> bounds, Job_system* job_system = nullptr, const size_t min_chunk_items = 64u);
+
+    /**
+     * @brief Collects ids of all items whose cells overlap the given area.
+     *
+     * @param area[in]      - Query rectangle.
+     * @param out_ids[out]  - Cleared, then filled with unique ids in ascending order.
+     *
+     * @note Only a broadphase: the caller still has to run the exact intersection test.
+     */
+    void query(const sf::FloatRect& area, std::pmr::vector<Id>& out_ids) const;
+
+    /** @returns Current cell size in pixels. */
+    FLEV_NODISCARD float get_cell_size() const;
+
+    /** @returns Number of items inserted by the last rebuild. */
+    FLEV_NODISCARD size_t get_item_count() const;
+
+    /**
+     * @brief Collects world rectangles of all cells holding at least one item (debug drawing).
+     *
+     * @param out_cells[out] - Cleared, then filled in unspecified order.
+     */
+    void get_occupied_cells(std::pmr::vector<sf::FloatRect>& out_cells) const;
+
+private/*types*/:
+
+    /** @brief Item id bound for one cell, collected by a rebuild chunk. */
+    struct Cell_entry
+    {
+        uint64_t key = 0u; ///< Cell key (see make_key()).
+        Id id = 0u;        ///< Item id.
+    };
+
+private/*methods*/:
+
+    /** @returns Cell coordinate for a world coordinate. */
+    FLEV_NODISCARD int32_t to_cell(const float value) const;
+
+    /** @brief Computes the inclusive cell range covered by a (possibly negative-size) rect. */
+    void to_cell_range(
+        const sf::FloatRect& box,
+        int32_t& min_x, int32_t& min_y,
+        int32_t& max_x, int32_t& max_y
+    ) const;
+
+    /** @returns Hash key of the cell (x, y). */
+    FLEV_NODISCARD static uint64_t make_key(const int32_t x, const int32_t y);
+
+private/*vars*/:
+
+    float min_cell_size_;                                           ///< Lower clamp for cell size.
+    float cell_size_;                                               ///< Current cell size.
+    float inv_cell_size_;                                           ///< 1 / cell_size_.
+    size_t item_count_ = 0;                                         ///< Items in the current build.
+    std::pmr::unsynchronized_pool_resource pool_;                   ///< Recycles nodes and cell vectors of erased cells.
+    std::pmr::unordered_map<uint64_t, std::pmr::vector<Id>> cells_; ///< Item ids per occupied cell (cell vectors share the map's memory).
+
+    // Per-chunk rebuild buffers. They live on the heap, not in pool_, because chunks grow them on
+    // worker threads; they keep their capacity between rebuilds
+    std::vector<float> chunk_extents_;                              ///< Sum of item extents per chunk.
+    std::vector<std::vector<Cell_entry>> chunk_entries_;            ///< (cell, id) pairs per chunk, in item order.
+};